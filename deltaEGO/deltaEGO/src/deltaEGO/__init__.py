@@ -1,4 +1,4 @@
-from ._version import __version__
-from .deltaEGO import deltaEGO 
-
+from ._version import __version__
+from .deltaEGO import deltaEGO 
+
 __all__ = ["deltaEGO", "__version__"]
\ No newline at end of file
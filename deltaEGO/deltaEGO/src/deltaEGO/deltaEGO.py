@@ -1,296 +1,443 @@
-from deltaEGO_VDB import EGOSearcher
-import deltaEGO_compute
-from typing import Union, List, Dict, TypedDict, Optional, TypeAlias
-from pathlib import Path
-import time, warnings
-
-# c++ stuct import ------------------------------------------------------------------------------------
-try:
-    CppVADPoint:        TypeAlias = deltaEGO_compute.VADPoint
-    CppEGO_axis:        TypeAlias = deltaEGO_compute.EGO_axis
-    CppVariable:        TypeAlias = deltaEGO_compute.variable
-    CppWeight:          TypeAlias = deltaEGO_compute.weight
-    CppComputeIn:       TypeAlias = deltaEGO_compute.compute_in
-    CppAnalysisResult: TypeAlias = deltaEGO_compute.AnalysisResult
-
-except AttributeError:  # failed to load cpp lib 
-    warnings.warn("="*50, ImportWarning)
-    warnings.warn("WARNING: from C++ module 'deltaEGO_compute', cannot find binding class !(ex. VADPoint).", ImportWarning)
-    warnings.warn("="*50, ImportWarning)
-    raise ImportError("Cannot find C++ binding class from analizer.")
-#------------------------------------------------------------------------------------------------------
-
-# for search
-class VAD_search(TypedDict):
-    V: float            # valance
-    A: float            # arousal
-    D: float            # dominance
-    k: int
-    dis: float          # distance
-    sigma: Optional[float]
-    api: Optional[str]
-
-# for analysis
-# VAD.hpp
-class VADPoint(TypedDict):       
-    v: float            # valance
-    a: float            # arousal
-    d: float            # dominance
-    timestamp: float    # when does this emotion generated
-    owner: str          # owner of this emotion
-
-class VAD_ave(TypedDict):
-    x: float
-    y: float
-    z: float
-    radius: float
-
-# input --------------------------------
-class weight(TypedDict, total=False): # total=False -> using cpp default
-    weightA_stress: float
-    weightV_stress: float
-    weightV_reward: float
-    weightA_reward: float
-    weight_k: float
-
-class variable(TypedDict, total=False):
-    theta_0: float
-    dampening_factor: float
-
-class EGO_axis(TypedDict, total=False):
-    baseline: VADPoint
-    stabilityRadius: float
-
-class _compute_in_mandatory(TypedDict):
-    current: VADPoint
-    history: List[VADPoint]
-
-class compute_in(_compute_in_mandatory, total=False):
-    prev: Optional[VADPoint]
-    emotion_base: Optional[EGO_axis]
-    variables: Optional[variable]
-    weights: Optional[weight]
-# input ---------------------------------
-
-# return --------------------------------
-class InstantMetrics(TypedDict):
-    stress: float
-    reward: float
-    ratio_total: float
-    stress_ratio: float
-    reward_ratio: float
-    deviation: float
-
-class DynamicMetrics(TypedDict):
-    delta: VADPoint
-    affective_lability: float
-
-class CumulativeMetrics(TypedDict):
-    average_area: VAD_ave
-    stress: float
-    reward: float
-    total: float
-    stress_ratio: float
-    reward_ratio: float
-
-class AnalysisResult_py(TypedDict):
-    instant: InstantMetrics
-    dynamics: DynamicMetrics
-    cumulative: CumulativeMetrics
-# return --------------------------------
-
-class deltaEGO:
-    def __init__(self, character_name:str, save_path:Optional[Path] = None):
-        self.ego_character:str = character_name
-        self.EGO_save_path: Optional[Path] = save_path #TODO
-        
-        # state
-        self.last_emotion: Optional[Dict] = None
-        self.last_emotion_VADPoint: Optional[VADPoint] = None
-        self.emotion_history: List[Dict] = []
-        self.emotion_history_VADPoint : List[VADPoint] = []
-        self.analysis_history: List[AnalysisResult_py] = []
-
-        # cpp modules
-        self.ego_searcher = EGOSearcher()
-        self.compute = deltaEGO_compute.compute
-
-        # VDB search default
-        self.DEFAULT_SIGMA: float = 0.5
-        self.DEFAULT_API_OPT: str = "knn~l2 -S"
-
-        # base line for emotion analize
-        self.default_axis = EGO_axis(
-            baseline = VADPoint(v=0.0, a=0.0, d=0.0, timestamp=0.0, owner="base"),
-            stabilityRadius = 0.3
-        )
-        self.default_weights = weight()     # C++ default
-        self.default_variables = variable() # C++ default
-
-        # flags
-        self.automatic_analize:bool = False
-        self.save: bool = False             #TODO
-
-
-    def VADsearch(self, in_VAD: VAD_search) -> dict:
-        # TODO: save and open emotion save data 
-        api_opt = in_VAD.get('api') or self.DEFAULT_API_OPT
-        sigma = in_VAD.get('sigma') or self.DEFAULT_SIGMA
-
-        ego_result: dict = self.ego_searcher.search(
-            V = in_VAD['V'],
-            A = in_VAD['A'],
-            D = in_VAD['D'],
-            k = in_VAD['k'],
-            d = in_VAD['dis'],
-            SIGMA = sigma,
-            opt = api_opt
-        )
-
-        current_vad_point = VADPoint(
-            v=in_VAD['V'], 
-            a=in_VAD['A'], 
-            d=in_VAD['D'],
-            timestamp=time.time(), 
-            owner=self.ego_character
-        )
-
-        # update history
-        self.emotion_history.append(ego_result)
-        self.emotion_history_VADPoint.append(current_vad_point)
-
-        # last state update
-        self.last_emotion = ego_result
-        self.last_emotion_VADPoint = current_vad_point
-
-        # does it needs to analize automatically?
-        if self.automatic_analize:
-            self.analize_VAD(return_analysis=False)
-
-        return ego_result
-
-    def _build_cpp_input_bundle(self, input_dict: compute_in):
-        """
-        Python TypedDict(compute_in) --> C++ CppComputeIn
-        """
-        try:
-            #  opt dict -> struct(CppEGO_axis)
-            current_Ea_dict = input_dict.get('emotion_base') or self.default_axis
-            baseline_cpp = CppVADPoint(**current_Ea_dict['baseline'])
-            ego_axis_cpp = CppEGO_axis(
-                baseline=baseline_cpp,
-                stabilityRadius=current_Ea_dict['stabilityRadius']
-            )
-            
-            variables_cpp = CppVariable(**(input_dict.get('variables') or self.default_variables))
-            weights_cpp = CppWeight(**(input_dict.get('weights') or self.default_weights))
-
-            # VADPoint(dict) -> CppVADPoint
-            current_cpp = CppVADPoint(**input_dict['current'])
-            
-            # prev(dict or None) -> CppVADPoint or None
-            prev_point_dict = input_dict.get('prev')
-            prev_cpp = CppVADPoint(**prev_point_dict) if prev_point_dict else None
-            
-            # hitstory -> List[CppVADPoint]
-            history_cpp = [CppVADPoint(**p) for p in input_dict['history']]
-
-            # final result (cppComputeIn)
-            return CppComputeIn(
-                current=current_cpp,
-                history=history_cpp, 
-                prev=prev_cpp,
-                emotion_base=ego_axis_cpp,
-                variables=variables_cpp,
-                weights=weights_cpp
-            )
-        except TypeError as e:
-            warnings.warn(f"fatal error while building cpp struct Error: {e}", RuntimeWarning)
-            raise e #
-
-    def analize_VAD(self, 
-                    weights:            Optional[weight] = None, 
-                    variables:          Optional[variable] = None, 
-                    emotion_base:       Optional[EGO_axis] = None, 
-                    return_analysis:    bool = True, 
-                    append_emotion:     bool = True
-                    ) -> Union[None, CppAnalysisResult]:
-        
-        if not self.last_emotion_VADPoint:
-            warnings.warn("Warning: No VAD data to analyze. Call VADsearch() first.", RuntimeWarning)
-            return None
-        
-        prev_point_dict: Optional[VADPoint] = None
-        if len(self.emotion_history_VADPoint) > 1:
-            prev_point_dict = self.emotion_history_VADPoint[-2]
-
-        # data to transfer to C++ module (Python TypedDict)
-        input_bundle_dict = compute_in(
-            current = self.last_emotion_VADPoint,
-            history = self.emotion_history_VADPoint,
-            prev = prev_point_dict, 
-            emotion_base = emotion_base or self.default_axis,
-            variables = variables or self.default_variables,
-            weights = weights or self.default_weights
-        )
-        
-        # dict -> cpp struct
-        input_bundle_cpp = self._build_cpp_input_bundle(input_bundle_dict)
-        
-        # call cpp module -> C++ object (AnalysisResultObject)
-        analyzed_result: CppAnalysisResult = self.compute(input_bundle_cpp)
-
-        # update
-        if append_emotion:
-            self.analysis_history.append(self.analysis_cpp_to_py(analyzed_result)) 
-        
-
-        if return_analysis:
-            return analyzed_result
-        else:
-            return None
-
-    # cpp -> py class translator
-    @staticmethod
-    def vadpoint_cpp_to_py(p: CppVADPoint) -> VADPoint:
-        return {
-            "v": p.v,
-            "a": p.a,
-            "d": p.d,
-            "timestamp": p.timestamp,
-            "owner": p.owner,
-        }
-    def analysis_cpp_to_py(self, res: CppAnalysisResult) -> AnalysisResult_py:
-        return {
-            "instant": 
-            {
-                "stress":        res.instant.stress,
-                "reward":        res.instant.reward,
-                "ratio_total":   res.instant.ratio_total,
-                "stress_ratio":  res.instant.stress_ratio,
-                "reward_ratio":  res.instant.reward_ratio,
-                "deviation":     res.instant.deviation,
-            },
-
-            "dynamics": 
-            {
-                "delta":               self.vadpoint_cpp_to_py(res.dynamics.delta),
-                "affective_lability":  res.dynamics.affective_lability,
-            },
-
-            "cumulative": 
-            {
-                "average_area": 
-                {
-                    "x": res.cumulative.average_area.x,
-                    "y": res.cumulative.average_area.y,
-                    "z": res.cumulative.average_area.z,
-                    "radius": res.cumulative.average_area.radius,
-                },
-                "stress":        res.cumulative.stress,
-                "reward":        res.cumulative.reward,
-                "total":         res.cumulative.total,
-                "stress_ratio":  res.cumulative.stress_ratio,
-                "reward_ratio":  res.cumulative.reward_ratio,
-            }
+from deltaEGO_VDB import EGOSearcher
+import deltaEGO_compute
+from typing import Union, List, Dict, TypedDict, Optional, TypeAlias
+from pathlib import Path
+from collections import deque
+import time, warnings
+
+# c++ stuct import ------------------------------------------------------------------------------------
+try:
+    CppVADPoint:        TypeAlias = deltaEGO_compute.VADPoint
+    CppVADHistory:      TypeAlias = deltaEGO_compute.VADHistory
+    CppHistoryIndex:    TypeAlias = deltaEGO_compute.HistoryIndex
+    CppAdaptiveBaseline: TypeAlias = deltaEGO_compute.AdaptiveBaseline
+    CppOneEuroFilter:   TypeAlias = deltaEGO_compute.OneEuroFilter
+    CppFilterOption:    TypeAlias = deltaEGO_compute.filter_option
+    CppHistoryLog:      TypeAlias = getattr(deltaEGO_compute, "HistoryLog", None) # POSIX only
+    CppEGO_axis:        TypeAlias = deltaEGO_compute.EGO_axis
+    CppVariable:        TypeAlias = deltaEGO_compute.variable
+    CppWeight:          TypeAlias = deltaEGO_compute.weight
+    CppComputeIn:       TypeAlias = deltaEGO_compute.compute_in
+    CppAnalysisResult: TypeAlias = deltaEGO_compute.AnalysisResult
+
+except AttributeError:  # failed to load cpp lib 
+    warnings.warn("="*50, ImportWarning)
+    warnings.warn("WARNING: from C++ module 'deltaEGO_compute', cannot find binding class !(ex. VADPoint).", ImportWarning)
+    warnings.warn("="*50, ImportWarning)
+    raise ImportError("Cannot find C++ binding class from analizer.")
+#------------------------------------------------------------------------------------------------------
+
+# for search
+class VAD_search(TypedDict):
+    V: float            # valance
+    A: float            # arousal
+    D: float            # dominance
+    k: int
+    dis: float          # distance
+    sigma: Optional[float]
+    api: Optional[str]
+
+# for analysis
+# VAD.hpp
+class VADPoint(TypedDict):       
+    v: float            # valance
+    a: float            # arousal
+    d: float            # dominance
+    timestamp: float    # when does this emotion generated
+    owner: str          # owner of this emotion
+
+class VAD_ave(TypedDict):
+    x: float
+    y: float
+    z: float
+    radius: float
+
+# input --------------------------------
+class weight(TypedDict, total=False): # total=False -> using cpp default
+    weightA_stress: float
+    weightV_stress: float
+    weightV_reward: float
+    weightA_reward: float
+    weight_k: float
+
+class variable(TypedDict, total=False):
+    theta_0: float
+    dampening_factor: float
+
+class EGO_axis(TypedDict, total=False):
+    baseline: VADPoint
+    stabilityRadius: float
+
+class _compute_in_mandatory(TypedDict):
+    current: VADPoint
+    history: List[VADPoint]
+
+class compute_in(_compute_in_mandatory, total=False):
+    prev: Optional[VADPoint]
+    emotion_base: Optional[EGO_axis]
+    variables: Optional[variable]
+    weights: Optional[weight]
+# input ---------------------------------
+
+# return --------------------------------
+class InstantMetrics(TypedDict):
+    stress: float
+    reward: float
+    ratio_total: float
+    stress_ratio: float
+    reward_ratio: float
+    deviation: float
+
+class DynamicMetrics(TypedDict):
+    delta: VADPoint
+    affective_lability: float
+
+class CumulativeMetrics(TypedDict):
+    average_area: VAD_ave
+    stress: float
+    reward: float
+    total: float
+    stress_ratio: float
+    reward_ratio: float
+
+class AnalysisResult_py(TypedDict):
+    instant: InstantMetrics
+    dynamics: DynamicMetrics
+    cumulative: CumulativeMetrics
+# return --------------------------------
+
+class deltaEGO:
+    # search results / analyses kept in emotion_history / analysis_history while a history_log is open
+    RECENT_RESULTS: int = 256
+
+    def __init__(self, character_name:str, save_path:Optional[Path] = None):
+        self.ego_character:str = character_name
+        self.EGO_save_path: Optional[Path] = save_path
+        
+        # state
+        self.last_emotion: Optional[Dict] = None
+        self.last_emotion_VADPoint: Optional[VADPoint] = None
+        self.emotion_history: Union[List[Dict], deque] = []   # bounded deque when history_log is open
+        self.emotion_history_cpp: CppVADHistory = CppVADHistory() # VAD history, kept native (no rebuild per analysis)
+        self.analysis_history: Union[List[AnalysisResult_py], deque] = []   # bounded deque when history_log is open
+
+        # cpp modules
+        self.ego_searcher = EGOSearcher()
+        self.compute = deltaEGO_compute.compute
+
+        # VDB search default
+        self.DEFAULT_SIGMA: float = 0.5
+        self.DEFAULT_API_OPT: str = "knn~l2 -S"
+
+        # base line for emotion analize
+        self.default_axis = EGO_axis(
+            baseline = VADPoint(v=0.0, a=0.0, d=0.0, timestamp=0.0, owner="base"),
+            stabilityRadius = 0.3
+        )
+        self.default_weights = weight()     # C++ default
+        self.default_variables = variable() # C++ default
+
+        # prefix sums of the history for time-range queries,
+        # built on the first cumulative_between() with the defaults above
+        self.history_index: Optional[CppHistoryIndex] = None
+        self._history_index_settings = None
+
+        # optional moving baseline (see set_adaptive_baseline)
+        self.adaptive_baseline: Optional[CppAdaptiveBaseline] = None
+
+        # optional input smoothing in front of search and history (see set_smoothing)
+        self.vad_filter: Optional[CppOneEuroFilter] = None
+
+        # persistent history: binary log under save_path, read back by mmap
+        self.history_log = None
+        if save_path is not None:
+            self._open_history_log(Path(save_path))
+
+        # flags
+        self.automatic_analize:bool = False
+        self.save: bool = self.history_log is not None
+
+
+    def VADsearch(self, in_VAD: VAD_search) -> dict:
+        api_opt = in_VAD.get('api') or self.DEFAULT_API_OPT
+        sigma = in_VAD.get('sigma') or self.DEFAULT_SIGMA
+        now = time.time()
+
+        # smoothed point replaces the raw one for search and history
+        if self.vad_filter is not None:
+            smoothed = self.vad_filter.filter(in_VAD['V'], in_VAD['A'], in_VAD['D'], now)
+            in_VAD = {**in_VAD, 'V': smoothed.v, 'A': smoothed.a, 'D': smoothed.d}
+
+        ego_result: dict = self.ego_searcher.search(
+            V = in_VAD['V'],
+            A = in_VAD['A'],
+            D = in_VAD['D'],
+            k = in_VAD['k'],
+            d = in_VAD['dis'],
+            SIGMA = sigma,
+            opt = api_opt
+        )
+
+        current_vad_point = VADPoint(
+            v=in_VAD['V'], 
+            a=in_VAD['A'], 
+            d=in_VAD['D'],
+            timestamp=now, 
+            owner=self.ego_character
+        )
+
+        # update history
+        self.emotion_history.append(ego_result)     # deque of the last RECENT_RESULTS when logging
+        if self.history_log is not None:
+            # VAD history lives only in the log; prev / history are read back from the mapping
+            self.history_log.append(**current_vad_point)
+        else:
+            self.emotion_history_cpp.append(**current_vad_point)
+        if self.history_index is not None:
+            self.history_index.push(current_vad_point['v'], current_vad_point['a'],
+                                    current_vad_point['d'], current_vad_point['timestamp'])
+        if self.adaptive_baseline is not None:
+            self.adaptive_baseline.push(current_vad_point['v'], current_vad_point['a'],
+                                        current_vad_point['d'], current_vad_point['timestamp'])
+
+        # last state update
+        self.last_emotion = ego_result
+        self.last_emotion_VADPoint = current_vad_point
+
+        # does it needs to analize automatically?
+        if self.automatic_analize:
+            self.analize_VAD(return_analysis=False)
+
+        return ego_result
+
+    def _index_settings(self) -> tuple:
+        # what the index bakes in; the dicts may be edited in place, so compare by value
+        return (
+            tuple(sorted(self.default_axis['baseline'].items())),
+            self.default_axis['stabilityRadius'],
+            tuple(sorted(self.default_weights.items())),
+            tuple(sorted(self.default_variables.items()))
+        )
+
+    def _get_history_index(self) -> CppHistoryIndex:
+        settings = self._index_settings()
+        if self.history_index is None or settings != self._history_index_settings:
+            history = self.history_log.as_array() if self.history_log is not None else self.emotion_history_cpp
+            self.history_index = CppHistoryIndex(
+                history,
+                emotion_base = CppEGO_axis(
+                    baseline = CppVADPoint(**self.default_axis['baseline']),
+                    stabilityRadius = self.default_axis['stabilityRadius']
+                ),
+                weights = CppWeight(**self.default_weights),
+                variables = CppVariable(**self.default_variables)
+            )
+            self._history_index_settings = settings
+        return self.history_index
+
+    def _open_history_log(self, save_path: Path):
+        if CppHistoryLog is None:
+            warnings.warn("HistoryLog is not available on this platform, history stays in memory.", RuntimeWarning)
+            return
+
+        save_path.mkdir(parents=True, exist_ok=True)
+        self.history_log = CppHistoryLog(str(save_path / f"{self.ego_character}.egolog"))
+
+        # search results and analyses are not in the log: keep only the recent ones
+        self.emotion_history = deque(self.emotion_history, maxlen=self.RECENT_RESULTS)
+        self.analysis_history = deque(self.analysis_history, maxlen=self.RECENT_RESULTS)
+
+        # resume a previous session straight from the mapped file
+        n = len(self.history_log)
+        if n > 0:
+            self.last_emotion_VADPoint = self.vadpoint_cpp_to_py(self.history_log[n - 1])
+
+    def set_adaptive_baseline(self, time_constant: Optional[float]):
+        """
+        Let the default baseline follow an EWMA of this character's VAD (time_constant in seconds).
+        None turns it off. Explicit emotion_base arguments to analize_VAD still win.
+        """
+        self.history_index = None
+        if time_constant is None:
+            self.adaptive_baseline = None
+            return
+        self.adaptive_baseline = CppAdaptiveBaseline(
+            time_constant, CppVADPoint(**self.default_axis['baseline'])
+        )
+
+    def set_smoothing(self, min_cutoff: Optional[float] = 0.01, beta: float = 0.5, d_cutoff: float = 1.0):
+        """
+        Smooth incoming VAD with a One-Euro filter (C++) before search and history.
+        min_cutoff=None turns it off.
+        """
+        if min_cutoff is None:
+            self.vad_filter = None
+            return
+        self.vad_filter = CppOneEuroFilter(CppFilterOption(min_cutoff, beta, d_cutoff))
+
+    def _current_axis(self) -> EGO_axis:
+        if self.adaptive_baseline is None:
+            return self.default_axis
+        return EGO_axis(
+            baseline = {**self.vadpoint_cpp_to_py(self.adaptive_baseline.value()), "owner": "base"},
+            stabilityRadius = self.default_axis['stabilityRadius']
+        )
+
+    def flush(self):
+        """fsync the history log (also done every few appends and on exit)"""
+        if self.history_log is not None:
+            self.history_log.flush()
+
+    def _build_cpp_input_bundle(self, input_dict: compute_in):
+        """
+        Python TypedDict(compute_in) --> C++ CppComputeIn
+        """
+        try:
+            #  opt dict -> struct(CppEGO_axis)
+            current_Ea_dict = input_dict.get('emotion_base') or self.default_axis
+            baseline_cpp = CppVADPoint(**current_Ea_dict['baseline'])
+            ego_axis_cpp = CppEGO_axis(
+                baseline=baseline_cpp,
+                stabilityRadius=current_Ea_dict['stabilityRadius']
+            )
+            
+            variables_cpp = CppVariable(**(input_dict.get('variables') or self.default_variables))
+            weights_cpp = CppWeight(**(input_dict.get('weights') or self.default_weights))
+
+            # VADPoint(dict) -> CppVADPoint
+            current_cpp = CppVADPoint(**input_dict['current'])
+            
+            # prev(dict or None) -> CppVADPoint or None
+            prev_point_dict = input_dict.get('prev')
+            prev_cpp = CppVADPoint(**prev_point_dict) if prev_point_dict else None
+            
+            # hitstory -> CppVADHistory (already native) or List[CppVADPoint]
+            history = input_dict['history']
+            if isinstance(history, CppVADHistory):
+                history_cpp = history
+            else:
+                history_cpp = [CppVADPoint(**p) for p in history]
+
+            # final result (cppComputeIn)
+            return CppComputeIn(
+                current=current_cpp,
+                history=history_cpp, 
+                prev=prev_cpp,
+                emotion_base=ego_axis_cpp,
+                variables=variables_cpp,
+                weights=weights_cpp
+            )
+        except TypeError as e:
+            warnings.warn(f"fatal error while building cpp struct Error: {e}", RuntimeWarning)
+            raise e #
+
+    def analize_VAD(self, 
+                    weights:            Optional[weight] = None, 
+                    variables:          Optional[variable] = None, 
+                    emotion_base:       Optional[EGO_axis] = None, 
+                    return_analysis:    bool = True, 
+                    append_emotion:     bool = True
+                    ) -> Union[None, CppAnalysisResult]:
+        
+        if not self.last_emotion_VADPoint:
+            warnings.warn("Warning: No VAD data to analyze. Call VADsearch() first.", RuntimeWarning)
+            return None
+        
+        prev_point_dict: Optional[VADPoint] = None
+        if self.history_log is not None:
+            if len(self.history_log) > 1:
+                prev_point_dict = self.vadpoint_cpp_to_py(self.history_log[len(self.history_log) - 2])
+        elif len(self.emotion_history_cpp) > 1:
+            prev_point_dict = self.vadpoint_cpp_to_py(self.emotion_history_cpp[len(self.emotion_history_cpp) - 2])
+
+        # data to transfer to C++ module (Python TypedDict)
+        input_bundle_dict = compute_in(
+            current = self.last_emotion_VADPoint,
+            history = self.emotion_history_cpp,
+            prev = prev_point_dict, 
+            emotion_base = emotion_base or self._current_axis(),
+            variables = variables or self.default_variables,
+            weights = weights or self.default_weights
+        )
+        
+        # dict -> cpp struct
+        input_bundle_cpp = self._build_cpp_input_bundle(input_bundle_dict)
+        
+        # call cpp module -> C++ object (AnalysisResultObject)
+        if self.history_log is not None:
+            # history is read from the mapped log
+            analyzed_result: CppAnalysisResult = self.compute(
+                input_bundle_cpp.current,
+                self.history_log,
+                input_bundle_cpp.prev,
+                input_bundle_cpp.emotion_base,
+                input_bundle_cpp.variables,
+                input_bundle_cpp.weights
+            )
+        else:
+            analyzed_result: CppAnalysisResult = self.compute(input_bundle_cpp)
+
+        # update
+        if append_emotion:
+            self.analysis_history.append(self.analysis_cpp_to_py(analyzed_result)) 
+        
+
+        if return_analysis:
+            return analyzed_result
+        else:
+            return None
+
+    def cumulative_between(self, t0: float, t1: float) -> CumulativeMetrics:
+        """
+        Cumulative metrics of the emotions recorded in [t0, t1] (unix time), O(log n).
+        Uses the default axis / weights / variables. Radius is the RMS distance to the center.
+        The index is built on the first call (O(n)) and again after those settings change.
+        """
+        return self.cumulative_cpp_to_py(self._get_history_index().query(t0, t1))
+
+    # cpp -> py class translator
+    @staticmethod
+    def vadpoint_cpp_to_py(p: CppVADPoint) -> VADPoint:
+        return {
+            "v": p.v,
+            "a": p.a,
+            "d": p.d,
+            "timestamp": p.timestamp,
+            "owner": p.owner,
+        }
+    def analysis_cpp_to_py(self, res: CppAnalysisResult) -> AnalysisResult_py:
+        return {
+            "instant": 
+            {
+                "stress":        res.instant.stress,
+                "reward":        res.instant.reward,
+                "ratio_total":   res.instant.ratio_total,
+                "stress_ratio":  res.instant.stress_ratio,
+                "reward_ratio":  res.instant.reward_ratio,
+                "deviation":     res.instant.deviation,
+            },
+
+            "dynamics": 
+            {
+                "delta":               self.vadpoint_cpp_to_py(res.dynamics.delta),
+                "affective_lability":  res.dynamics.affective_lability,
+            },
+
+            "cumulative": self.cumulative_cpp_to_py(res.cumulative)
+        }
+    @staticmethod
+    def cumulative_cpp_to_py(c) -> CumulativeMetrics:
+        return {
+            "average_area": 
+            {
+                "x": c.average_area.x,
+                "y": c.average_area.y,
+                "z": c.average_area.z,
+                "radius": c.average_area.radius,
+            },
+            "stress":        c.stress,
+            "reward":        c.reward,
+            "total":         c.total,
+            "stress_ratio":  c.stress_ratio,
+            "reward_ratio":  c.reward_ratio,
         }
\ No newline at end of file
@@ -0,0 +1,345 @@
+#include "VAD_generate.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace
+{
+    inline double clamp_axis(double x)
+    {
+        return std::min(1.0, std::max(-1.0, x));
+    }
+
+    inline Point3D clamp_point(const Point3D& p)
+    {
+        return Point3D{clamp_axis(p.x), clamp_axis(p.y), clamp_axis(p.z)};
+    }
+
+    std::string make_term(vad_distribution distribution, std::size_t idx)
+    {
+        return std::string(distribution_name(distribution)) + "_" + std::to_string(idx);
+    }
+
+    /*
+    Samplers built straight on mt19937_64 bits.
+    The std distributions (uniform_real, normal, discrete ...) are implementation defined,
+    so the same seed gave different datasets with libstdc++ / libc++ / MSVC. mt19937_64 itself is fully specified.
+    */
+
+    // top 53 bits -> [0, 1)
+    inline double unit_double(std::mt19937_64& rng)
+    {
+        return static_cast<double>(rng() >> 11) * 0x1.0p-53;
+    }
+
+    inline double uniform_axis(std::mt19937_64& rng)
+    {
+        return -1.0 + 2.0 * unit_double(rng);
+    }
+
+    // [0, n), n > 0
+    inline std::size_t uniform_index(std::mt19937_64& rng, std::size_t n)
+    {
+        return std::min(n - 1, static_cast<std::size_t>(unit_double(rng) * static_cast<double>(n)));
+    }
+
+    // Box-Muller, cosine branch only: two draws per sample keeps the draw order simple
+    inline double gaussian(std::mt19937_64& rng, double mean, double stddev)
+    {
+        const double u1 = 1.0 - unit_double(rng);   // (0, 1], log(u1) is finite
+        const double u2 = unit_double(rng);
+        return mean + stddev * std::sqrt(-2.0 * std::log(u1)) * std::cos(6.28318530717958647693 * u2);
+    }
+
+    /*
+    Index i with probability weight[i] / total, from the running sums of the weights.
+    Zero weights are never picked; all zero -> uniform.
+    Time complexity: O(log N)
+    */
+    std::size_t pick_weighted(const std::vector<double>& cumulative, std::mt19937_64& rng)
+    {
+        const double total = cumulative.back();
+        if (!(total > 0))
+            return uniform_index(rng, cumulative.size());
+        const double u = unit_double(rng) * total;
+        const std::size_t idx = std::upper_bound(cumulative.begin(), cumulative.end(), u) - cumulative.begin();
+        return std::min(idx, cumulative.size() - 1);
+    }
+
+    std::vector<double> running_sum(const std::vector<double>& weights)
+    {
+        std::vector<double> cumulative(weights.size());
+        double sum = 0;
+        for (std::size_t i = 0; i < weights.size(); i++)
+            cumulative[i] = (sum += weights[i]);
+        return cumulative;
+    }
+
+    /*
+    Samples one point from a mixture: pick a component by weight, then one Gaussian per axis.
+    Samples outside the cube are clamped (keeps the order of draws fixed -> reproducible).
+    */
+    Point3D sample_mixture(const std::vector<MixtureComponent>& mixture, const std::vector<double>& cumulative,
+                           std::mt19937_64& rng)
+    {
+        const MixtureComponent& c = mixture[pick_weighted(cumulative, rng)];
+        const double x = gaussian(rng, c.mean.x, c.stddev.x);
+        const double y = gaussian(rng, c.mean.y, c.stddev.y);
+        const double z = gaussian(rng, c.mean.z, c.stddev.z);
+        return clamp_point(Point3D{x, y, z});
+    }
+
+    inline double log_gauss(double x, double mean, double stddev)
+    {
+        const double z = (x - mean) / stddev;
+        return -0.5 * z * z - std::log(stddev) - 0.91893853320467274178;   // log(sqrt(2 pi))
+    }
+}
+
+const char* distribution_name(vad_distribution distribution)
+{
+    switch (distribution)
+    {
+        case vad_distribution::uniform:    return "uniform";
+        case vad_distribution::clustered:  return "clustered";
+        case vad_distribution::duplicated: return "duplicated";
+        case vad_distribution::planar:     return "planar";
+    }
+    return "uniform";
+}
+
+vad_distribution parse_distribution(const std::string& name)
+{
+    if (name == "uniform")    return vad_distribution::uniform;
+    if (name == "clustered")  return vad_distribution::clustered;
+    if (name == "duplicated") return vad_distribution::duplicated;
+    if (name == "planar")     return vad_distribution::planar;
+    throw std::invalid_argument("unknown distribution: " + name + " (uniform, clustered, duplicated, planar)");
+}
+
+std::vector<MixtureComponent> default_mixture()
+{
+    return {
+        {0.24, { 0.00,  0.00,  0.00}, {0.20, 0.20, 0.20}},   // neutral core
+        {0.14, { 0.55,  0.35,  0.40}, {0.18, 0.20, 0.20}},   // pleasant, active
+        {0.14, { 0.50, -0.35,  0.20}, {0.18, 0.18, 0.20}},   // pleasant, calm
+        {0.14, {-0.55,  0.45, -0.10}, {0.18, 0.20, 0.25}},   // unpleasant, active
+        {0.14, {-0.50, -0.30, -0.35}, {0.18, 0.18, 0.20}},   // unpleasant, calm
+        {0.08, { 0.85,  0.70,  0.75}, {0.08, 0.10, 0.10}},   // strong positive corner
+        {0.06, {-0.85,  0.80,  0.30}, {0.08, 0.10, 0.20}},   // strong negative, high arousal
+        {0.06, {-0.80, -0.75, -0.80}, {0.10, 0.10, 0.10}},   // strong negative, low arousal
+    };
+}
+
+/*
+EM for a diagonal Gaussian mixture.
+    1. k-means++ picks the starting means (far apart, seeded)
+    2. E step: responsibilities in log space (no underflow far from every mean)
+    3. M step: weights / means / per-axis stddev, stddev floored at 1e-3
+*/
+std::vector<MixtureComponent> fit_mixture(const std::vector<Emotion>& data, int components, int iterations,
+                                          std::uint64_t seed)
+{
+    if (data.empty() || components <= 0)
+        throw std::invalid_argument("fit_mixture needs data and components > 0");
+
+    const std::size_t n = data.size();
+    const std::size_t m = std::min<std::size_t>(components, n);
+    std::mt19937_64 rng(seed);
+
+    // k-means++ start
+    std::vector<MixtureComponent> mixture;
+    std::vector<double> nearest(n, std::numeric_limits<double>::infinity());
+    std::size_t chosen = uniform_index(rng, n);
+    for (std::size_t c = 0; c < m; c++)
+    {
+        const Point3D& p = data[chosen].point;
+        mixture.push_back({1.0 / m, p, {0.25, 0.25, 0.25}});
+
+        for (std::size_t i = 0; i < n; i++)
+        {
+            const Point3D& q = data[i].point;
+            const double dx = q.x - p.x, dy = q.y - p.y, dz = q.z - p.z;
+            nearest[i] = std::min(nearest[i], dx * dx + dy * dy + dz * dz);
+        }
+        chosen = pick_weighted(running_sum(nearest), rng);
+    }
+
+    std::vector<double> resp(n * m);
+    for (int it = 0; it < iterations; it++)
+    {
+        // E step
+        for (std::size_t i = 0; i < n; i++)
+        {
+            const Point3D& q = data[i].point;
+            double best = -std::numeric_limits<double>::infinity();
+            for (std::size_t c = 0; c < m; c++)
+            {
+                const MixtureComponent& g = mixture[c];
+                const double l = std::log(g.weight)
+                               + log_gauss(q.x, g.mean.x, g.stddev.x)
+                               + log_gauss(q.y, g.mean.y, g.stddev.y)
+                               + log_gauss(q.z, g.mean.z, g.stddev.z);
+                resp[i * m + c] = l;
+                best = std::max(best, l);
+            }
+            double total = 0;
+            for (std::size_t c = 0; c < m; c++)
+                total += (resp[i * m + c] = std::exp(resp[i * m + c] - best));
+            for (std::size_t c = 0; c < m; c++)
+                resp[i * m + c] /= total;
+        }
+
+        // M step
+        for (std::size_t c = 0; c < m; c++)
+        {
+            double w = 0, sx = 0, sy = 0, sz = 0;
+            for (std::size_t i = 0; i < n; i++)
+            {
+                const double r = resp[i * m + c];
+                const Point3D& q = data[i].point;
+                w += r; sx += r * q.x; sy += r * q.y; sz += r * q.z;
+            }
+            if (w <= 1e-12)
+                continue;   // empty component keeps its previous shape
+
+            const Point3D mean{sx / w, sy / w, sz / w};
+            double vx = 0, vy = 0, vz = 0;
+            for (std::size_t i = 0; i < n; i++)
+            {
+                const double r = resp[i * m + c];
+                const Point3D& q = data[i].point;
+                vx += r * (q.x - mean.x) * (q.x - mean.x);
+                vy += r * (q.y - mean.y) * (q.y - mean.y);
+                vz += r * (q.z - mean.z) * (q.z - mean.z);
+            }
+            mixture[c].weight = w / n;
+            mixture[c].mean = mean;
+            mixture[c].stddev = Point3D{std::max(1e-3, std::sqrt(vx / w)),
+                                        std::max(1e-3, std::sqrt(vy / w)),
+                                        std::max(1e-3, std::sqrt(vz / w))};
+        }
+    }
+    return mixture;
+}
+
+std::vector<Emotion> generate_emotions(const generate_option& option)
+{
+    std::mt19937_64 rng(option.seed);
+
+    std::vector<Emotion> out;
+    out.reserve(option.size);
+
+    switch (option.distribution)
+    {
+        case vad_distribution::uniform:
+        {
+            for (std::size_t i = 0; i < option.size; i++)
+            {
+                const double x = uniform_axis(rng), y = uniform_axis(rng), z = uniform_axis(rng);
+                out.push_back(Emotion{make_term(option.distribution, i), Point3D{x, y, z}});
+            }
+            break;
+        }
+        case vad_distribution::clustered:
+        {
+            const std::vector<MixtureComponent> mixture = option.mixture.empty() ? default_mixture() : option.mixture;
+            std::vector<double> weights;
+            for (const MixtureComponent& c : mixture)
+            {
+                if (!(c.weight >= 0) || !(c.stddev.x > 0 && c.stddev.y > 0 && c.stddev.z > 0))
+                    throw std::invalid_argument("mixture needs weight >= 0 and stddev > 0");
+                weights.push_back(c.weight);
+            }
+            const std::vector<double> cumulative = running_sum(weights);
+
+            for (std::size_t i = 0; i < option.size; i++)
+                out.push_back(Emotion{make_term(option.distribution, i), sample_mixture(mixture, cumulative, rng)});
+            break;
+        }
+        case vad_distribution::duplicated:
+        {
+            if (!(option.unique_ratio > 0.0 && option.unique_ratio <= 1.0))
+                throw std::invalid_argument("unique_ratio must be in (0, 1]");
+
+            const std::size_t distinct = std::max<std::size_t>(1, static_cast<std::size_t>(option.size * option.unique_ratio));
+            std::vector<Point3D> base(distinct);
+            for (Point3D& p : base)
+            {
+                const double x = uniform_axis(rng), y = uniform_axis(rng), z = uniform_axis(rng);
+                p = Point3D{x, y, z};
+            }
+
+            // skewed reuse: a few points get most of the copies (like repeated phrases)
+            for (std::size_t i = 0; i < option.size; i++)
+            {
+                const double u = unit_double(rng);
+                const std::size_t idx = std::min(distinct - 1, static_cast<std::size_t>(u * u * u * distinct));
+                out.push_back(Emotion{make_term(option.distribution, i), base[idx]});
+            }
+            break;
+        }
+        case vad_distribution::planar:
+        {
+            const double z = clamp_axis(option.plane_z);
+            for (std::size_t i = 0; i < option.size; i++)
+            {
+                const double x = uniform_axis(rng), y = uniform_axis(rng);
+                out.push_back(Emotion{make_term(option.distribution, i), Point3D{x, y, z}});
+            }
+            break;
+        }
+    }
+    return out;
+}
+
+bool write_emotions_json(const std::string& path, const std::vector<Emotion>& emotions)
+{
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs.is_open())
+        return false;
+
+    // streamed by hand: a 50M element nlohmann::json array would not fit in memory
+    ofs << "[";
+    for (std::size_t i = 0; i < emotions.size(); i++)
+    {
+        const Emotion& e = emotions[i];
+        json item = {{"term", e.term}, {"valence", e.point.x}, {"arousal", e.point.y}, {"dominance", e.point.z}};
+        ofs << (i ? ",\n" : "\n") << item.dump();
+    }
+    ofs << "\n]\n";
+    return static_cast<bool>(ofs);
+}
+
+bool write_emotions_binary(const std::string& path, const std::vector<Emotion>& emotions)
+{
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs.is_open())
+        return false;
+
+    const char magic[8] = {'V', 'A', 'D', 'B', 'I', 'N', '1', '\0'};
+    const std::uint64_t count = emotions.size();
+    ofs.write(magic, sizeof magic);
+    ofs.write(reinterpret_cast<const char*>(&count), sizeof count);
+
+    for (const Emotion& e : emotions)
+    {
+        const double xyz[3] = {e.point.x, e.point.y, e.point.z};
+        ofs.write(reinterpret_cast<const char*>(xyz), sizeof xyz);
+    }
+
+    std::uint64_t end = 0;
+    for (const Emotion& e : emotions)
+    {
+        end += e.term.size();
+        ofs.write(reinterpret_cast<const char*>(&end), sizeof end);
+    }
+    for (const Emotion& e : emotions)
+        ofs.write(e.term.data(), static_cast<std::streamsize>(e.term.size()));
+
+    return static_cast<bool>(ofs);
+}
@@ -0,0 +1,86 @@
+#ifndef VAD_GENERATE_HPP
+#define VAD_GENERATE_HPP
+
+#include "VAD_customVDB.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+Synthetic VAD datasets for scale testing (1M ~ 50M points).
+Every generator is reproducible: same option + same seed -> same points, same order.
+Points are in [-1, 1]^3 like the lexicon.
+
+    * uniform    : uniform in the cube
+    * clustered  : Gaussian mixture (default mixture, or one fit to a real dataset with fit_mixture)
+    * duplicated : few distinct points repeated many times (nth_element with many equal keys)
+    * planar     : every point on the plane z = plane_z (one axis gives no split at all)
+*/
+
+enum class vad_distribution
+{
+    uniform,
+    clustered,
+    duplicated,
+    planar
+};
+
+// one diagonal Gaussian of a mixture
+struct MixtureComponent
+{
+    double weight;
+    Point3D mean;
+    Point3D stddev;
+};
+
+struct generate_option
+{
+    vad_distribution distribution = vad_distribution::uniform;
+    std::size_t size = 100000;
+    std::uint64_t seed = 42;
+
+    std::vector<MixtureComponent> mixture;  // clustered: empty -> default_mixture()
+    double unique_ratio = 0.01;             // duplicated: distinct points / size
+    double plane_z = 0.0;                   // planar: dominance of every point
+};
+
+/*
+A fixed 8 component mixture (valence / arousal quadrants, a neutral core, a few strong corners).
+Use fit_mixture on the real lexicon for a closer match.
+*/
+std::vector<MixtureComponent> default_mixture();
+
+/*
+Fits a diagonal Gaussian mixture to existing points with EM (k-means++ start).
+Time complexity: O(iterations * N * components)
+*/
+std::vector<MixtureComponent> fit_mixture(const std::vector<Emotion>& data, int components = 8,
+                                          int iterations = 50, std::uint64_t seed = 42);
+
+/*
+Generates option.size emotions named "<distribution>_<index>".
+Throws std::invalid_argument for a bad option (empty mixture weights, unique_ratio <= 0 ...).
+Time complexity: O(N)
+*/
+std::vector<Emotion> generate_emotions(const generate_option& option);
+
+const char* distribution_name(vad_distribution distribution);
+vad_distribution parse_distribution(const std::string& name);
+
+/*
+Writers for the two formats KDTree can load:
+    * JSON (VAD.json schema: [{"term", "valence", "arousal", "dominance"}, ...]) -> KDTree::load_data
+    * binary (below)                                                           -> KDTree::load_binary
+
+Binary layout (little endian):
+    char[8]   magic "VADBIN1\0"
+    uint64    count
+    double    points[count][3]        valence, arousal, dominance
+    uint64    term_end[count]         end offset of each term in the blob
+    char      blob[term_end[count-1]] terms back to back, no separators
+Return false if the file can't be written.
+*/
+bool write_emotions_json(const std::string& path, const std::vector<Emotion>& emotions);
+bool write_emotions_binary(const std::string& path, const std::vector<Emotion>& emotions);
+
+#endif
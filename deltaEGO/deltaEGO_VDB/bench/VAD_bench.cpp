@@ -0,0 +1,265 @@
+/*
+ * Native benchmark of the VDB engine (no Python, no pybind11).
+ * Measures load_data, build_tree_with_iterative and search over dataset sizes, k, d and
+ * every visit / similarity / flag option, and reports throughput and p50/p90/p99/p99.9 latency.
+ *
+ *   vdb_bench [--sizes 1000,10000,100000] [--dists uniform,clustered,duplicated,planar]
+ *             [--data emotions.json|dataset.bin] [--queries 2000]
+ *             [--ks 1,8,32] [--ds 0.1,0.5] [--apis tree,hits,json] [--visits knn,knn_d]
+ *             [--sims none,d,l2,cos,gauss,gauss_w] [--flags ,B,D,S,E]
+ *             [--repeat 5] [--seed 42] [--sigma 0.5] [--json out.json]
+ *
+ * Sizes x dists are synthetic datasets (generate_emotions, VAD_generate.hpp) written to a
+ * temp JSON file, so load_data is measured on the same path as real data.
+ * --data adds a real file (.bin files go through load_binary).
+ */
+#include "VAD_customVDB.hpp"
+#include "VAD_generate.hpp"
+#include "bench_common.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// input struct----
+struct BenchConfig
+{
+    std::vector<std::size_t> sizes{1000, 10000, 100000};
+    std::vector<std::string> dists{"uniform"};
+    std::vector<std::string> data_files;
+    std::size_t queries = 2000;
+    std::vector<int> ks{1, 8, 32};
+    std::vector<double> ds{0.1, 0.5};
+    std::vector<std::string> apis{"tree", "hits", "json"};
+    std::vector<std::string> visits{"knn", "knn_d"};
+    std::vector<std::string> sims{"none", "d", "l2", "cos", "gauss", "gauss_w"};
+    std::vector<std::string> flags{"", "B", "D", "S", "E"};
+    std::size_t repeat = 5;
+    std::uint64_t seed = 42;
+    double sigma = 0.5;
+    std::string json_path;
+};
+// input struct----
+
+// parsing -------------------------------------------------------------------------
+BenchConfig parse_args(int argc, char** argv)
+{
+    BenchConfig config;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string key = argv[i];
+        if (key == "-h" || key == "--help")
+        {
+            std::puts("vdb_bench [--sizes N,..] [--dists uniform,clustered,duplicated,planar]\n"
+                      "          [--data file.json|file.bin] [--queries N] [--ks k,..] [--ds d,..]\n"
+                      "          [--apis tree,hits,json] [--visits knn,knn_d] [--sims none,d,l2,cos,gauss,gauss_w]\n"
+                      "          [--flags ,B,D,S,E] [--repeat N] [--seed N] [--sigma s] [--json out.json]");
+            std::exit(0);
+        }
+        if (i + 1 >= argc)
+            throw std::invalid_argument("missing value for " + key);
+
+        const std::string value = argv[++i];
+        if (key == "--sizes")        config.sizes = parse_list<std::size_t>(value, [](const std::string& s) { return std::stoull(s); });
+        else if (key == "--dists")   config.dists = split_list(value);
+        else if (key == "--data")    config.data_files.push_back(value);
+        else if (key == "--queries") config.queries = std::stoull(value);
+        else if (key == "--ks")      config.ks = parse_list<int>(value, [](const std::string& s) { return std::stoi(s); });
+        else if (key == "--ds")      config.ds = parse_list<double>(value, [](const std::string& s) { return std::stod(s); });
+        else if (key == "--apis")    config.apis = split_list(value);
+        else if (key == "--visits")  config.visits = split_list(value);
+        else if (key == "--sims")    config.sims = split_list(value);
+        else if (key == "--flags")   config.flags = split_list(value);
+        else if (key == "--repeat")  config.repeat = std::max<std::size_t>(1, std::stoull(value));
+        else if (key == "--seed")    config.seed = std::stoull(value);
+        else if (key == "--sigma")   config.sigma = std::stod(value);
+        else if (key == "--json")    config.json_path = value;
+        else throw std::invalid_argument("unknown option " + key);
+    }
+    return config;
+}
+// parsing -------------------------------------------------------------------------
+
+// dataset -------------------------------------------------------------------------
+std::filesystem::path write_synthetic(vad_distribution distribution, std::size_t size, std::uint64_t seed)
+{
+    generate_option option;
+    option.distribution = distribution;
+    option.size = size;
+    option.seed = seed ^ size;
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path()
+                                     / ("vdb_bench_" + std::string(distribution_name(distribution)) + "_"
+                                        + std::to_string(size) + "_" + std::to_string(seed) + ".json");
+    if (!write_emotions_json(path.string(), generate_emotions(option)))
+        throw std::runtime_error("can't write " + path.string());
+    return path;
+}
+// dataset -------------------------------------------------------------------------
+
+/*
+ * One dataset: load / build over `repeat` runs, then every search case over the same queries.
+ * Time complexity: O(repeat * N log N + cases * queries * search)
+ */
+json bench_dataset(const BenchConfig& config, const std::string& name, const std::string& path)
+{
+    json report;
+    report["name"] = name;
+
+    KDTree tree;
+    const LatencyStats load = time_each(config.repeat, [&](std::size_t)
+    {
+        if (!quiet_load(tree, path))
+            throw std::runtime_error("load_data failed: " + path);
+    });
+
+    const std::size_t size = tree.Emotions.size();
+    std::vector<int> P_buffer(size);
+    const LatencyStats build = time_each(config.repeat, [&](std::size_t)
+    {
+        std::iota(P_buffer.begin(), P_buffer.end(), 0);
+        tree.root = tree.build_tree_with_iterative(P_buffer);
+    });
+
+    report["size"] = size;
+    report["load_data"] = stats_json(load);
+    report["build_tree_with_iterative"] = stats_json(build);
+    std::printf("\n[%s] %zu items  load_data p50 %.2f ms  build p50 %.2f ms\n",
+                name.c_str(), size, load.p50_ns / 1e6, build.p50_ns / 1e6);
+    std::printf("%-5s %-6s %-8s %-4s %4s %5s %12s %10s %10s %10s %10s\n",
+                "api", "visit", "sim", "flag", "k", "d", "qps", "p50 ns", "p90 ns", "p99 ns", "p99.9 ns");
+
+    // same queries for every case
+    std::mt19937_64 rng(config.seed);
+    std::uniform_real_distribution<double> axis(-1.0, 1.0);
+    std::vector<Point3D> queries(config.queries);
+    for (Point3D& q : queries)
+        q = Point3D{axis(rng), axis(rng), axis(rng)};
+
+    std::size_t sink = 0;   // keeps results observable
+    json cases = json::array();
+    auto run_case = [&](const std::string& api, const std::string& visit, const std::string& sim,
+                        const std::string& flag, int k, double d)
+    {
+        const std::string opt = visit + "~" + sim + (flag.empty() ? "" : " -" + flag);
+        auto op = [&](std::size_t i)
+        {
+            const Point3D& q = queries[i % queries.size()];
+            if (api == "tree")
+                sink += tree.search_tree(q, k, d, visit).size();
+            else if (api == "hits")
+                sink += tree.VAD_search_hits(q.x, q.y, q.z, k, d, config.sigma, opt).size();
+            else
+                sink += tree.VAD_search_near_k(q.x, q.y, q.z, k, d, config.sigma, opt).size();
+        };
+
+        // warm up caches / allocator
+        for (std::size_t i = 0; i < std::min<std::size_t>(100, queries.size()); i++)
+            op(i);
+
+        const LatencyStats s = time_each(queries.size(), op);
+        std::printf("%-5s %-6s %-8s %-4s %4d %5.2f %12.0f %10.0f %10.0f %10.0f %10.0f\n",
+                    api.c_str(), visit.c_str(), sim.c_str(), flag.c_str(), k, d,
+                    s.throughput, s.p50_ns, s.p90_ns, s.p99_ns, s.p999_ns);
+
+        json row = stats_json(s);
+        row["api"] = api; row["visit"] = visit; row["sim"] = sim; row["flag"] = flag;
+        row["k"] = k; row["d"] = d; row["opt"] = opt;
+        cases.push_back(std::move(row));
+    };
+
+    for (const std::string& api : config.apis)
+        for (const std::string& visit : config.visits)
+            for (int k : config.ks)
+                for (std::size_t di = 0; di < config.ds.size(); di++)
+                {
+                    const double d = config.ds[di];
+                    // d only changes knn_d traversal and the "d" similarity
+                    const bool d_matters = (visit == "knn_d");
+
+                    // tree walk: no similarity, no JSON
+                    if (api == "tree")
+                    {
+                        if (d_matters || di == 0)
+                            run_case(api, visit, "none", "", k, d);
+                        continue;
+                    }
+                    for (const std::string& sim : config.sims)
+                    {
+                        if (!d_matters && sim != "d" && di > 0)
+                            continue;
+
+                        // flags only shape the JSON output
+                        if (api == "hits")
+                            run_case(api, visit, sim, "", k, d);
+                        else
+                            for (const std::string& flag : config.flags)
+                                run_case(api, visit, sim, flag, k, d);
+                    }
+                }
+
+    report["search"] = std::move(cases);
+    report["checksum"] = sink;
+    return report;
+}
+
+int main(int argc, char** argv)
+{
+    BenchConfig config;
+    try
+    {
+        config = parse_args(argc, argv);
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "vdb_bench: %s (see --help)\n", e.what());
+        return 2;
+    }
+
+    json report;
+    report["config"] = {{"queries", config.queries}, {"repeat", config.repeat}, {"seed", config.seed}, {"dists", config.dists},
+                        {"sigma", config.sigma}, {"ks", config.ks}, {"ds", config.ds}};
+    report["machine"] = {{"hardware_threads", std::thread::hardware_concurrency()}};
+
+    json datasets = json::array();
+    try
+    {
+        for (const std::string& dist : config.dists)
+        {
+            const vad_distribution distribution = parse_distribution(dist);
+            for (std::size_t size : config.sizes)
+            {
+                const std::filesystem::path path = write_synthetic(distribution, size, config.seed);
+                datasets.push_back(bench_dataset(config, dist + "_" + std::to_string(size), path.string()));
+                std::filesystem::remove(path);
+            }
+        }
+        for (const std::string& path : config.data_files)
+            datasets.push_back(bench_dataset(config, std::filesystem::path(path).filename().string(), path));
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "vdb_bench: %s\n", e.what());
+        return 1;
+    }
+    report["datasets"] = std::move(datasets);
+
+    if (!config.json_path.empty())
+    {
+        std::ofstream out(config.json_path);
+        out << report.dump(2) << "\n";
+        std::printf("\nwrote %s\n", config.json_path.c_str());
+    }
+    return 0;
+}
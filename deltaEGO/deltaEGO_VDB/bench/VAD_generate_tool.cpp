@@ -0,0 +1,120 @@
+/*
+ * Writes reproducible synthetic VAD datasets for scale testing (see VAD_generate.hpp).
+ *
+ *   vad_generate --out data.json [--dist uniform|clustered|duplicated|planar] [--size 1000000]
+ *                [--seed 42] [--format json|bin] [--fit lexicon.json] [--clusters 8]
+ *                [--unique 0.01] [--plane-z 0.0]
+ *
+ * --fit reads a real VAD.json (or .bin), fits a --clusters component Gaussian mixture to it and uses
+ * that for --dist clustered (the fitted mixture is printed so it can be kept with the data).
+ * --format defaults to the --out extension (.bin -> binary, anything else -> JSON).
+ */
+#include "VAD_customVDB.hpp"
+#include "VAD_generate.hpp"
+#include "bench_common.hpp"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+// input struct----
+struct ToolConfig
+{
+    generate_option option;
+    std::string out_path;
+    std::string format;     // "json" / "bin", empty -> from out_path
+    std::string fit_path;
+    int clusters = 8;
+};
+// input struct----
+
+// parsing -------------------------------------------------------------------------
+ToolConfig parse_args(int argc, char** argv)
+{
+    ToolConfig config;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string key = argv[i];
+        if (key == "-h" || key == "--help")
+        {
+            std::puts("vad_generate --out file.json|file.bin [--dist uniform|clustered|duplicated|planar]\n"
+                      "             [--size N] [--seed N] [--format json|bin] [--fit lexicon.json] [--clusters N]\n"
+                      "             [--unique ratio] [--plane-z z]");
+            std::exit(0);
+        }
+        if (i + 1 >= argc)
+            throw std::invalid_argument("missing value for " + key);
+
+        const std::string value = argv[++i];
+        if (key == "--out")           config.out_path = value;
+        else if (key == "--dist")     config.option.distribution = parse_distribution(value);
+        else if (key == "--size")     config.option.size = std::stoull(value);
+        else if (key == "--seed")     config.option.seed = std::stoull(value);
+        else if (key == "--format")   config.format = value;
+        else if (key == "--fit")      config.fit_path = value;
+        else if (key == "--clusters") config.clusters = std::stoi(value);
+        else if (key == "--unique")   config.option.unique_ratio = std::stod(value);
+        else if (key == "--plane-z")  config.option.plane_z = std::stod(value);
+        else throw std::invalid_argument("unknown option " + key);
+    }
+
+    if (config.out_path.empty())
+        throw std::invalid_argument("--out is required");
+    if (config.format.empty())
+        config.format = std::filesystem::path(config.out_path).extension() == ".bin" ? "bin" : "json";
+    if (config.format != "json" && config.format != "bin")
+        throw std::invalid_argument("--format must be json or bin");
+    return config;
+}
+// parsing -------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    ToolConfig config;
+    try
+    {
+        config = parse_args(argc, argv);
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "vad_generate: %s (see --help)\n", e.what());
+        return 2;
+    }
+
+    try
+    {
+        if (!config.fit_path.empty())
+        {
+            // keep stdout for the mixture
+            KDTree source;
+            if (!quiet_load(source, config.fit_path))
+                throw std::runtime_error("load failed: " + config.fit_path);
+
+            config.option.mixture = fit_mixture(source.Emotions, config.clusters, 50, config.option.seed);
+            std::printf("mixture fit to %s (%zu points)\n", config.fit_path.c_str(), source.Emotions.size());
+            for (const MixtureComponent& c : config.option.mixture)
+                std::printf("  w %.4f  mean (% .4f, % .4f, % .4f)  std (%.4f, %.4f, %.4f)\n",
+                            c.weight, c.mean.x, c.mean.y, c.mean.z, c.stddev.x, c.stddev.y, c.stddev.z);
+        }
+
+        const auto begin = std::chrono::steady_clock::now();
+        const std::vector<Emotion> emotions = generate_emotions(config.option);
+        const bool ok = config.format == "bin" ? write_emotions_binary(config.out_path, emotions)
+                                               : write_emotions_json(config.out_path, emotions);
+        if (!ok)
+            throw std::runtime_error("can't write " + config.out_path);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+        std::printf("wrote %zu %s points (seed %llu) to %s as %s in %.1f ms\n",
+                    emotions.size(), distribution_name(config.option.distribution),
+                    static_cast<unsigned long long>(config.option.seed), config.out_path.c_str(),
+                    config.format.c_str(), ms);
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "vad_generate: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
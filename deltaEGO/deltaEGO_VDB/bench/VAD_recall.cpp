@@ -0,0 +1,435 @@
+/*
+ * Recall vs latency of non-exact search configurations, against the exact k-d tree.
+ * For every query set and k it runs the exact search_tree("knn") as ground truth, then each
+ * configuration over the same queries, and reports recall@k, distance ratio and latency
+ * percentiles as a table sorted by p50 latency (Pareto-optimal rows are marked with *).
+ *
+ *   vdb_recall [--dist clustered] [--size 100000] [--data file.json|file.bin]
+ *              [--query-dists uniform,fitted,near] [--replay traffic.egolog] [--queries 2000]
+ *              [--ks 1,8,32] [--eps 0,0.1,0.25,0.5,1,2] [--max-visits 0,32,128,512]
+ *              [--radius 0.1,0.25,0.5] [--seed 42] [--json out.json]
+ *
+ * Configurations:
+ *   knn   eps x max-visits grid (approx_option; eps 0 + max-visits 0 is the exact row)
+ *   knn_d every --radius (hits limited to the radius)
+ *
+ * Query sets:
+ *   uniform  uniform in [-1, 1]^3
+ *   fitted   Gaussian mixture fit to the dataset (queries look like the data)
+ *   near     dataset points + N(0, 0.02) noise
+ *   replay   every --replay file, in recorded order:
+ *              * HistoryLog files (DEGOLOG1 header, deltaEGO's .egolog) -> V, A, D of each record
+ *              * anything else is read as raw double[3] (V, A, D) triples
+ *
+ * A hit counts for recall@k when its distance is within the true k-th distance, so ties
+ * (duplicated points) are not counted as misses.
+ * Distance ratio is the mean of hit distance / true distance of the same rank (1 = exact).
+ */
+#include "VAD_customVDB.hpp"
+#include "VAD_generate.hpp"
+#include "bench_common.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// input struct----
+struct RecallConfig
+{
+    std::string dist = "clustered";
+    std::size_t size = 100000;
+    std::string data_path;
+    std::vector<std::string> query_dists{"uniform", "fitted", "near"};
+    std::vector<std::string> replay_files;
+    std::size_t queries = 2000;
+    std::vector<int> ks{1, 8, 32};
+    std::vector<double> eps{0, 0.1, 0.25, 0.5, 1, 2};
+    std::vector<std::size_t> max_visits{0, 32, 128, 512};
+    std::vector<double> radius{0.1, 0.25, 0.5};
+    std::uint64_t seed = 42;
+    std::string json_path;
+};
+
+// one search configuration
+struct SearchCase
+{
+    std::string visit;      // "knn" / "knn_d"
+    double d = 1.0;         // knn_d radius
+    approx_option approx;
+};
+
+struct QuerySet
+{
+    std::string name;
+    std::vector<Point3D> points;
+};
+// input struct----
+
+// return struct----
+struct RecallRow
+{
+    SearchCase search;
+    double recall = 0;          // mean recall@k over queries
+    double distance_ratio = 0;  // mean hit / true distance of the same rank
+    LatencyStats latency;
+    bool pareto = false;
+};
+// return struct----
+
+// parsing -------------------------------------------------------------------------
+RecallConfig parse_args(int argc, char** argv)
+{
+    RecallConfig config;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string key = argv[i];
+        if (key == "-h" || key == "--help")
+        {
+            std::puts("vdb_recall [--dist uniform|clustered|duplicated|planar] [--size N] [--data file.json|file.bin]\n"
+                      "           [--query-dists uniform,fitted,near] [--replay file] [--queries N] [--ks k,..]\n"
+                      "           [--eps e,..] [--max-visits n,..] [--radius r,..] [--seed N] [--json out.json]");
+            std::exit(0);
+        }
+        if (i + 1 >= argc)
+            throw std::invalid_argument("missing value for " + key);
+
+        const std::string value = argv[++i];
+        if (key == "--dist")               config.dist = value;
+        else if (key == "--size")          config.size = std::stoull(value);
+        else if (key == "--data")          config.data_path = value;
+        else if (key == "--query-dists")   config.query_dists = split_list(value);
+        else if (key == "--replay")        config.replay_files.push_back(value);
+        else if (key == "--queries")       config.queries = std::max<std::size_t>(1, std::stoull(value));
+        else if (key == "--ks")            config.ks = parse_list<int>(value, [](const std::string& s) { return std::stoi(s); });
+        else if (key == "--eps")           config.eps = parse_list<double>(value, [](const std::string& s) { return std::stod(s); });
+        else if (key == "--max-visits")    config.max_visits = parse_list<std::size_t>(value, [](const std::string& s) { return std::stoull(s); });
+        else if (key == "--radius")        config.radius = parse_list<double>(value, [](const std::string& s) { return std::stod(s); });
+        else if (key == "--seed")          config.seed = std::stoull(value);
+        else if (key == "--json")          config.json_path = value;
+        else throw std::invalid_argument("unknown option " + key);
+    }
+    parse_distribution(config.dist);    // throws on a bad name
+    return config;
+}
+// parsing -------------------------------------------------------------------------
+
+// queries -------------------------------------------------------------------------
+/*
+ * Logged VAD traffic: a HistoryLog file (64 byte header, 40 byte records) or raw double[3] triples.
+ * A torn last record is dropped like HistoryLog does on open.
+ * Time complexity: O(n)
+ */
+std::vector<Point3D> load_replay(const std::string& path)
+{
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs.is_open())
+        throw std::runtime_error("can't open " + path);
+    const std::string bytes((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+    const bool is_history_log = bytes.size() >= 64 && std::memcmp(bytes.data(), "DEGOLOG1", 8) == 0;
+    const std::size_t offset = is_history_log ? 64 : 0;
+    const std::size_t stride = is_history_log ? 5 * sizeof(double) : 3 * sizeof(double);
+
+    std::vector<Point3D> points;
+    points.reserve((bytes.size() - offset) / stride);
+    for (std::size_t at = offset; at + stride <= bytes.size(); at += stride)
+    {
+        double vad[3];
+        std::memcpy(vad, bytes.data() + at, sizeof vad);
+        points.push_back(Point3D{vad[0], vad[1], vad[2]});
+    }
+    if (points.empty())
+        throw std::runtime_error("no VAD records in " + path);
+    return points;
+}
+
+QuerySet make_queries(const std::string& name, const KDTree& tree, const RecallConfig& config)
+{
+    QuerySet set{name, {}};
+    set.points.reserve(config.queries);
+    std::mt19937_64 rng(config.seed ^ 0x9e3779b97f4a7c15ULL);
+
+    if (name == "uniform")
+    {
+        std::uniform_real_distribution<double> axis(-1.0, 1.0);
+        for (std::size_t i = 0; i < config.queries; i++)
+        {
+            const double x = axis(rng), y = axis(rng), z = axis(rng);
+            set.points.push_back(Point3D{x, y, z});
+        }
+    }
+    else if (name == "fitted")
+    {
+        // EM on a sample is enough to get the shape
+        std::vector<Emotion> sample;
+        std::uniform_int_distribution<std::size_t> pick(0, tree.Emotions.size() - 1);
+        for (std::size_t i = 0; i < std::min<std::size_t>(20000, tree.Emotions.size()); i++)
+            sample.push_back(tree.Emotions[pick(rng)]);
+
+        generate_option option;
+        option.distribution = vad_distribution::clustered;
+        option.size = config.queries;
+        option.seed = config.seed + 1;
+        option.mixture = fit_mixture(sample, 8, 30, config.seed);
+        for (const Emotion& e : generate_emotions(option))
+            set.points.push_back(e.point);
+    }
+    else if (name == "near")
+    {
+        std::uniform_int_distribution<std::size_t> pick(0, tree.Emotions.size() - 1);
+        std::normal_distribution<double> noise(0.0, 0.02);
+        for (std::size_t i = 0; i < config.queries; i++)
+        {
+            const Point3D& p = tree.Emotions[pick(rng)].point;
+            const double x = p.x + noise(rng), y = p.y + noise(rng), z = p.z + noise(rng);
+            set.points.push_back(Point3D{x, y, z});
+        }
+    }
+    else
+        throw std::invalid_argument("unknown query set " + name + " (uniform, fitted, near)");
+    return set;
+}
+// queries -------------------------------------------------------------------------
+
+// accuracy ------------------------------------------------------------------------
+/*
+ * Brute force k smallest squared distances; checks the ground truth itself on a few queries.
+ * Time complexity: O(N)
+ */
+std::vector<double> brute_force_knn(const KDTree& tree, const Point3D& q, int k)
+{
+    std::vector<double> d2(tree.Emotions.size());
+    for (std::size_t i = 0; i < d2.size(); i++)
+    {
+        const Point3D& p = tree.Emotions[i].point;
+        d2[i] = (p.x - q.x) * (p.x - q.x) + (p.y - q.y) * (p.y - q.y) + (p.z - q.z) * (p.z - q.z);
+    }
+    const std::size_t kk = std::min<std::size_t>(k, d2.size());
+    std::partial_sort(d2.begin(), d2.begin() + kk, d2.end());
+    d2.resize(kk);
+    return d2;
+}
+
+/*
+ * recall@k and distance ratio of one query (hits and truth are nearest first, squared distances).
+ */
+void score_query(const std::vector<Hit>& hits, const std::vector<Hit>& truth, double& recall, double& ratio_sum,
+                 std::size_t& ratio_count)
+{
+    if (truth.empty())
+    {
+        recall += 1.0;
+        return;
+    }
+    const double kth = truth.back().first;
+    const double tolerance = kth * 1e-12 + 1e-300;
+
+    std::size_t found = 0;
+    for (const Hit& h : hits)
+        if (h.first <= kth + tolerance)
+            found++;
+    recall += static_cast<double>(std::min(found, truth.size())) / truth.size();
+
+    for (std::size_t i = 0; i < std::min(hits.size(), truth.size()); i++)
+    {
+        const double exact = std::sqrt(truth[i].first);
+        ratio_sum += (exact > 0) ? std::sqrt(hits[i].first) / exact : 1.0;
+        ratio_count++;
+    }
+}
+
+// no other row has recall >= and p50 <= with one of them strictly better
+void mark_pareto(std::vector<RecallRow>& rows)
+{
+    for (RecallRow& row : rows)
+    {
+        row.pareto = true;
+        for (const RecallRow& other : rows)
+        {
+            const bool no_worse = other.recall >= row.recall && other.latency.p50_ns <= row.latency.p50_ns;
+            const bool better = other.recall > row.recall || other.latency.p50_ns < row.latency.p50_ns;
+            if (no_worse && better)
+            {
+                row.pareto = false;
+                break;
+            }
+        }
+    }
+}
+// accuracy ------------------------------------------------------------------------
+
+std::vector<SearchCase> make_cases(const RecallConfig& config)
+{
+    std::vector<SearchCase> cases;
+    for (double eps : config.eps)
+        for (std::size_t visits : config.max_visits)
+            cases.push_back(SearchCase{"knn", 1.0, approx_option{eps, visits}});
+    for (double r : config.radius)
+        cases.push_back(SearchCase{"knn_d", r, approx_option{}});
+    return cases;
+}
+
+/*
+ * One query set at one k: ground truth, then every case over the same queries.
+ * Time complexity: O(cases * queries * search)
+ */
+nlohmann::json run_group(KDTree& tree, const QuerySet& set, int k, const std::vector<SearchCase>& cases)
+{
+    const std::vector<Point3D>& queries = set.points;
+    const double unlimited = std::numeric_limits<double>::infinity();
+
+    // ground truth: exact k-d tree
+    std::vector<std::vector<Hit>> truth(queries.size());
+    const LatencyStats exact = time_each(queries.size(), [&](std::size_t i)
+    {
+        truth[i] = tree.search_tree(queries[i], k, unlimited, "knn");
+    });
+
+    // and the tree against brute force on a few queries
+    std::size_t truth_errors = 0;
+    for (std::size_t i = 0; i < std::min<std::size_t>(32, queries.size()); i++)
+    {
+        const std::vector<double> expect = brute_force_knn(tree, queries[i], k);
+        if (expect.size() != truth[i].size())
+            truth_errors++;
+        else
+            for (std::size_t j = 0; j < expect.size(); j++)
+                if (expect[j] != truth[i][j].first) { truth_errors++; break; }
+    }
+    if (truth_errors > 0)
+        throw std::runtime_error("exact k-d tree disagrees with brute force on " + std::to_string(truth_errors) + " queries");
+
+    std::vector<RecallRow> rows;
+    std::vector<std::vector<Hit>> hits(queries.size());
+    for (const SearchCase& c : cases)
+    {
+        auto op = [&](std::size_t i) { hits[i] = tree.search_tree(queries[i], k, c.d, c.visit, c.approx); };
+
+        // warm up caches / allocator
+        for (std::size_t i = 0; i < std::min<std::size_t>(100, queries.size()); i++)
+            op(i);
+
+        RecallRow row;
+        row.search = c;
+        row.latency = time_each(queries.size(), op);
+
+        double recall = 0, ratio_sum = 0;
+        std::size_t ratio_count = 0;
+        for (std::size_t i = 0; i < queries.size(); i++)
+            score_query(hits[i], truth[i], recall, ratio_sum, ratio_count);
+        row.recall = recall / queries.size();
+        row.distance_ratio = ratio_count ? ratio_sum / ratio_count : 1.0;
+        rows.push_back(row);
+    }
+
+    mark_pareto(rows);
+    std::sort(rows.begin(), rows.end(), [](const RecallRow& a, const RecallRow& b) { return a.latency.p50_ns < b.latency.p50_ns; });
+
+    std::printf("\n[%s] k=%d  %zu queries  exact p50 %.0f ns  p99 %.0f ns\n",
+                set.name.c_str(), k, queries.size(), exact.p50_ns, exact.p99_ns);
+    std::printf("  %-6s %5s %6s %7s %9s %9s %10s %10s %10s %10s\n",
+                "visit", "d", "eps", "visits", "recall", "dist", "qps", "p50 ns", "p99 ns", "p99.9 ns");
+
+    nlohmann::json group;
+    group["query_set"] = set.name;
+    group["k"] = k;
+    group["queries"] = queries.size();
+    group["exact"] = stats_json(exact);
+    nlohmann::json out_rows = nlohmann::json::array();
+    for (const RecallRow& r : rows)
+    {
+        std::printf("%s %-6s %5.2f %6.2f %7zu %9.4f %9.4f %10.0f %10.0f %10.0f %10.0f\n",
+                    r.pareto ? "*" : " ", r.search.visit.c_str(), r.search.visit == "knn_d" ? r.search.d : 0.0,
+                    r.search.approx.eps, r.search.approx.max_visits, r.recall, r.distance_ratio,
+                    r.latency.throughput, r.latency.p50_ns, r.latency.p99_ns, r.latency.p999_ns);
+
+        nlohmann::json row = stats_json(r.latency);
+        row["visit"] = r.search.visit;
+        row["d"] = r.search.d;
+        row["eps"] = r.search.approx.eps;
+        row["max_visits"] = r.search.approx.max_visits;
+        row["recall"] = r.recall;
+        row["distance_ratio"] = r.distance_ratio;
+        row["pareto"] = r.pareto;
+        out_rows.push_back(std::move(row));
+    }
+    group["rows"] = std::move(out_rows);
+    return group;
+}
+
+int main(int argc, char** argv)
+{
+    RecallConfig config;
+    try
+    {
+        config = parse_args(argc, argv);
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "vdb_recall: %s (see --help)\n", e.what());
+        return 2;
+    }
+
+    nlohmann::json report;
+    try
+    {
+        KDTree tree;
+        std::string dataset;
+        if (!config.data_path.empty())
+        {
+            if (!quiet_load(tree, config.data_path))
+                throw std::runtime_error("load failed: " + config.data_path);
+            dataset = std::filesystem::path(config.data_path).filename().string();
+        }
+        else
+        {
+            generate_option option;
+            option.distribution = parse_distribution(config.dist);
+            option.size = config.size;
+            option.seed = config.seed;
+            tree.load_emotions(generate_emotions(option));
+            dataset = config.dist + "_" + std::to_string(config.size);
+        }
+        if (tree.Emotions.empty())
+            throw std::runtime_error("dataset is empty");
+        std::printf("dataset %s: %zu points\n", dataset.c_str(), tree.Emotions.size());
+
+        std::vector<QuerySet> sets;
+        for (const std::string& name : config.query_dists)
+            sets.push_back(make_queries(name, tree, config));
+        for (const std::string& path : config.replay_files)
+            sets.push_back(QuerySet{"replay:" + std::filesystem::path(path).filename().string(), load_replay(path)});
+
+        const std::vector<SearchCase> cases = make_cases(config);
+        nlohmann::json groups = nlohmann::json::array();
+        for (const QuerySet& set : sets)
+            for (int k : config.ks)
+                groups.push_back(run_group(tree, set, k, cases));
+
+        report["dataset"] = {{"name", dataset}, {"size", tree.Emotions.size()}};
+        report["config"] = {{"queries", config.queries}, {"seed", config.seed}, {"ks", config.ks},
+                            {"eps", config.eps}, {"max_visits", config.max_visits}, {"radius", config.radius}};
+        report["groups"] = std::move(groups);
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "vdb_recall: %s\n", e.what());
+        return 1;
+    }
+
+    if (!config.json_path.empty())
+    {
+        std::ofstream out(config.json_path);
+        out << report.dump(2) << "\n";
+        std::printf("\nwrote %s\n", config.json_path.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+#ifndef BENCH_COMMON_HPP
+#define BENCH_COMMON_HPP
+/*
+ * Helpers shared by the native tools (vdb_bench, vdb_recall): list parsing, latency percentiles, quiet loading.
+ */
+#include "VAD_customVDB.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using bench_clock = std::chrono::steady_clock;
+
+// return struct----
+struct LatencyStats
+{
+    std::size_t count = 0;
+    double total_ms = 0;
+    double throughput = 0;      // operations per second
+    double mean_ns = 0, p50_ns = 0, p90_ns = 0, p99_ns = 0, p999_ns = 0, max_ns = 0;
+};
+// return struct----
+
+// parsing -------------------------------------------------------------------------
+inline std::vector<std::string> split_list(const std::string& text)
+{
+    std::vector<std::string> out;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        out.push_back(item);
+    if (!text.empty() && text.back() == ',')
+        out.emplace_back();
+    return out;
+}
+
+template <typename T, typename Parse>
+std::vector<T> parse_list(const std::string& text, Parse parse)
+{
+    std::vector<T> out;
+    for (const std::string& item : split_list(text))
+        out.push_back(parse(item));
+    return out;
+}
+// parsing -------------------------------------------------------------------------
+
+/*
+ * Nearest-rank percentiles of the per-operation latencies.
+ * Time complexity: O(n log n)
+ */
+inline LatencyStats summarize(std::vector<double>& samples_ns, double total_ms)
+{
+    LatencyStats s;
+    if (samples_ns.empty())
+        return s;
+
+    std::sort(samples_ns.begin(), samples_ns.end());
+    auto rank = [&](double q)
+    {
+        const std::size_t idx = static_cast<std::size_t>(std::ceil(q * samples_ns.size()));
+        return samples_ns[std::min(samples_ns.size() - 1, idx == 0 ? 0 : idx - 1)];
+    };
+
+    s.count = samples_ns.size();
+    s.total_ms = total_ms;
+    s.throughput = (total_ms > 0) ? s.count / (total_ms / 1e3) : 0.0;
+    s.mean_ns = std::accumulate(samples_ns.begin(), samples_ns.end(), 0.0) / s.count;
+    s.p50_ns = rank(0.50);
+    s.p90_ns = rank(0.90);
+    s.p99_ns = rank(0.99);
+    s.p999_ns = rank(0.999);
+    s.max_ns = samples_ns.back();
+    return s;
+}
+
+inline nlohmann::json stats_json(const LatencyStats& s)
+{
+    return nlohmann::json{{"count", s.count}, {"total_ms", s.total_ms}, {"throughput_per_s", s.throughput},
+                          {"mean_ns", s.mean_ns}, {"p50_ns", s.p50_ns}, {"p90_ns", s.p90_ns},
+                          {"p99_ns", s.p99_ns}, {"p99_9_ns", s.p999_ns}, {"max_ns", s.max_ns}};
+}
+
+/*
+ * Times op() `count` times, one clock read per call.
+ * Time complexity: O(count * op)
+ */
+template <typename Op>
+LatencyStats time_each(std::size_t count, Op&& op)
+{
+    std::vector<double> samples(count);
+    const auto begin = bench_clock::now();
+    auto last = begin;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        op(i);
+        const auto now = bench_clock::now();
+        samples[i] = std::chrono::duration<double, std::nano>(now - last).count();
+        last = now;
+    }
+    const double total_ms = std::chrono::duration<double, std::milli>(last - begin).count();
+    return summarize(samples, total_ms);
+}
+
+// load_data prints progress to std::cout; keep it out of the report
+inline bool quiet_load(KDTree& tree, const std::string& path)
+{
+    if (std::filesystem::path(path).extension() == ".bin")
+        return tree.load_binary(path);
+
+    std::ostringstream sink;
+    std::streambuf* old = std::cout.rdbuf(sink.rdbuf());
+    const bool ok = tree.load_data(path);
+    std::cout.rdbuf(old);
+    return ok;
+}
+
+#endif
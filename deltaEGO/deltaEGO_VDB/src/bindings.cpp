@@ -1,31 +1,142 @@
-#include <pybind11/pybind11.h>
-#include <pybind11/stl.h> // std::string
-#include <VAD_customVDB.hpp>
-
-namespace py = pybind11;
-
-PYBIND11_MODULE(core, m) {
-    m.doc() = "pybind11 bindings for EGO_VDB KDTree";
-
-    py::class_<KDTree>(m, "KDTree")
-        // constructor
-        .def(py::init<>())
-
-        // load_data
-        .def("load_data", &KDTree::load_data,
-             py::arg("json_path"),
-             "Loads the VAD data from a JSON file.")
-
-        // search
-        .def("VAD_search_near_k", &KDTree::VAD_search_near_k,
-             "Searches for nearest emotions in the VAD space.",
-             py::arg("V"),
-             py::arg("A"),
-             py::arg("D"),
-             py::arg("k"),
-             py::arg("d"),
-             py::arg("SIGMA"),
-             py::arg("opt") = "knn"
-        );
-    
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h> // std::string
+#include <VAD_customVDB.hpp>
+#include <VAD_generate.hpp>
+#include <stdexcept>
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(core, m) {
+    m.doc() = "pybind11 bindings for EGO_VDB KDTree";
+
+    py::class_<SearchHit>(m, "SearchHit")
+        .def_readonly("idx", &SearchHit::idx)
+        .def_readonly("distance_pow2", &SearchHit::distance_pow2)
+        .def_readonly("similarity_percent", &SearchHit::similarity_percent);
+
+    // synthetic datasets
+    py::enum_<vad_distribution>(m, "vad_distribution")
+        .value("uniform", vad_distribution::uniform)
+        .value("clustered", vad_distribution::clustered)
+        .value("duplicated", vad_distribution::duplicated)
+        .value("planar", vad_distribution::planar);
+
+    py::class_<generate_option>(m, "generate_option")
+        .def(py::init<>())
+        .def(py::init([](vad_distribution distribution, std::size_t size, std::uint64_t seed,
+                         double unique_ratio, double plane_z)
+             {
+                 generate_option option;
+                 option.distribution = distribution;
+                 option.size = size;
+                 option.seed = seed;
+                 option.unique_ratio = unique_ratio;
+                 option.plane_z = plane_z;
+                 return option;
+             }),
+             py::arg("distribution") = vad_distribution::uniform,
+             py::arg("size") = 100000,
+             py::arg("seed") = 42,
+             py::arg("unique_ratio") = 0.01,
+             py::arg("plane_z") = 0.0)
+        .def_readwrite("distribution", &generate_option::distribution)
+        .def_readwrite("size", &generate_option::size)
+        .def_readwrite("seed", &generate_option::seed)
+        .def_readwrite("unique_ratio", &generate_option::unique_ratio)
+        .def_readwrite("plane_z", &generate_option::plane_z);
+
+    // generate + write; raises ValueError for a bad option / format, RuntimeError if the file can't be written
+    m.def("write_dataset",
+          [](const std::string& path, const generate_option& option, const std::string& format)
+          {
+              if (format != "json" && format != "bin")
+                  throw std::invalid_argument("format must be 'json' or 'bin'");
+
+              py::gil_scoped_release release;
+              const std::vector<Emotion> emotions = generate_emotions(option);
+              const bool ok = format == "bin" ? write_emotions_binary(path, emotions)
+                                              : write_emotions_json(path, emotions);
+              if (!ok)
+                  throw std::runtime_error("can't write " + path);
+              return emotions.size();
+          },
+          "Writes a reproducible synthetic VAD dataset (VAD.json schema or binary), returns the point count.",
+          py::arg("path"),
+          py::arg("option") = generate_option{},
+          py::arg("format") = "json");
+
+    py::class_<KDTree>(m, "KDTree")
+        // constructor
+        .def(py::init<>())
+
+        // load_data
+        .def("load_data", &KDTree::load_data,
+             py::arg("json_path"),
+             "Loads the VAD data from a JSON file.")
+
+        // binary dataset of write_dataset(format="bin")
+        .def("load_binary", &KDTree::load_binary,
+             py::arg("bin_path"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Loads a binary VAD dataset (write_dataset format='bin').")
+
+        // synthetic data without a file
+        .def("load_synthetic",
+             [](KDTree& tree, const generate_option& option){ tree.load_emotions(generate_emotions(option)); },
+             py::arg("option") = generate_option{},
+             py::call_guard<py::gil_scoped_release>(),
+             "Generates a synthetic dataset in memory and builds the tree on it.")
+
+        // number of loaded emotions
+        .def("size", [](const KDTree& tree){ return tree.Emotions.size(); })
+
+        // search
+        .def("VAD_search_near_k", &KDTree::VAD_search_near_k,
+             "Searches for nearest emotions in the VAD space.",
+             py::arg("V"),
+             py::arg("A"),
+             py::arg("D"),
+             py::arg("k"),
+             py::arg("d"),
+             py::arg("SIGMA"),
+             py::arg("opt") = "knn"
+        )
+
+        // search without JSON
+        .def("VAD_search_hits", &KDTree::VAD_search_hits,
+             "Same search as VAD_search_near_k, returns SearchHit list (nearest first).",
+             py::arg("V"),
+             py::arg("A"),
+             py::arg("D"),
+             py::arg("k"),
+             py::arg("d"),
+             py::arg("SIGMA"),
+             py::arg("opt") = "knn"
+        )
+
+        // traversal only, with the non-exact knobs (eps = 0, max_visits = 0 is exact)
+        .def("search_tree",
+             [](KDTree& tree, double V, double A, double D, int k, double d, const std::string& visit,
+                double eps, std::size_t max_visits)
+             {
+                 if (tree.root < 0 || k <= 0)
+                     return std::vector<Hit>{};
+                 return tree.search_tree(Point3D{V, A, D}, k, d, visit, approx_option{eps, max_visits});
+             },
+             "Returns (distance_pow2, idx) pairs, nearest first.",
+             py::arg("V"),
+             py::arg("A"),
+             py::arg("D"),
+             py::arg("k"),
+             py::arg("d") = 1.0,
+             py::arg("visit") = "knn",
+             py::arg("eps") = 0.0,
+             py::arg("max_visits") = 0,
+             py::call_guard<py::gil_scoped_release>())
+
+        // emotion name of a SearchHit.idx
+        .def("term", [](const KDTree& tree, int idx)
+             { return (idx == NEUTRAL_IDX) ? std::string("neutral") : tree.Emotions.at(idx).term; },
+             py::arg("idx"));
+    
 }
\ No newline at end of file
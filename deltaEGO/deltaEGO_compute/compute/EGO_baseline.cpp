@@ -0,0 +1,51 @@
+#include "EGO_baseline.hpp"
+#include <cmath>
+#include <stdexcept>
+
+AdaptiveBaseline::AdaptiveBaseline(double time_constant, const VADPoint& initial)
+    : time_constant(time_constant), v(initial.v), a(initial.a), d(initial.d)
+{
+    this->set_time_constant(time_constant);
+}
+
+void AdaptiveBaseline::set_time_constant(double time_constant)
+{
+    if (!(time_constant > 0))
+        throw std::invalid_argument("time_constant must be positive");
+    this->time_constant = time_constant;
+}
+
+/*
+ * Time complexity: O(1)
+ */
+void AdaptiveBaseline::push(double V, double A, double D, double timestamp)
+{
+    const double dt_raw = this->has_last ? timestamp - this->last_timestamp : 0.0;
+    const double dt = (dt_raw <= 0) ? 0.1 : dt_raw;
+    const double alpha = -std::expm1(-dt / this->time_constant);   // 1 - e^(-dt/tau), exact for tiny dt
+
+    this->v += alpha * (V - this->v);
+    this->a += alpha * (A - this->a);
+    this->d += alpha * (D - this->d);
+
+    this->last_timestamp = timestamp;
+    this->has_last = true;
+}
+
+void AdaptiveBaseline::reset(const VADPoint& initial)
+{
+    this->v = initial.v;
+    this->a = initial.a;
+    this->d = initial.d;
+    this->last_timestamp = 0;
+    this->has_last = false;
+}
+
+EGO_axis AdaptiveBaseline::apply(const EGO_axis& base) const
+{
+    EGO_axis out = base;
+    out.baseline.v = this->v;
+    out.baseline.a = this->a;
+    out.baseline.d = this->d;
+    return out;
+}
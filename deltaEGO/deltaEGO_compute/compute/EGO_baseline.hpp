@@ -0,0 +1,34 @@
+#pragma once
+#include "EGO_compute.hpp"
+
+/*
+ * Baseline that follows a character's settled mood: an exponentially weighted moving
+ * average of V/A/D with a time constant in seconds,
+ *   b <- b + (1 - e^(-dt / time_constant)) * (x - b).
+ * Starts at `initial` (the static EGO_axis baseline), so a short chat barely moves it.
+ * dt <= 0 is treated as 0.1 s, like the stress / reward kernels.
+ * Irregular sampling is fine: weight depends on elapsed time, not on sample count.
+ * Time complexity: O(1) per sample, Space complexity: O(1)
+ */
+class AdaptiveBaseline
+{
+    public:
+    explicit AdaptiveBaseline(double time_constant, const VADPoint& initial = VADPoint{0.0, 0.0, 0.0, 0.0});
+
+    void push(double V, double A, double D, double timestamp);
+    void push(const VADPoint& point) { this->push(point.v, point.a, point.d, point.timestamp); }
+    void reset(const VADPoint& initial);
+
+    VADPoint value() const { return VADPoint{this->v, this->a, this->d, this->last_timestamp}; }
+    // `base` with its baseline replaced by the current value (stabilityRadius is kept)
+    EGO_axis apply(const EGO_axis& base) const;
+
+    double get_time_constant() const { return this->time_constant; }
+    void set_time_constant(double time_constant);
+
+    private:
+    double time_constant;
+    double v, a, d;
+    double last_timestamp = 0;
+    bool has_last = false;
+};
@@ -0,0 +1,121 @@
+#include "EGO_baselines.hpp"
+#include <algorithm>
+#include <cmath>
+#include "EGO_kernel.hpp"
+
+namespace
+{
+    // samples per tile: the shared columns stay in L1 while every baseline walks them
+    constexpr std::size_t TILE = 1024;
+
+    struct Baseline_Test
+    {
+        double v, a, d;
+        double radius_pow2;     // -1 when stabilityRadius is negative (never inside)
+    };
+
+    /*
+     * Sum of stress * dt over the tile samples inside one baseline's stability radius.
+     * Time complexity: O(count)
+     */
+    inline double inside_stress(const Baseline_Test& base, const double* tv, const double* ta, const double* td,
+                                const double* stress_dt, std::size_t count)
+    {
+        double lane[4] = {};
+        std::size_t j = 0;
+        for (; j + 4 <= count; j += 4)
+        {
+            for (std::size_t l = 0; l < 4; l++)
+            {
+                const double dx = tv[j + l] - base.v;
+                const double dy = ta[j + l] - base.a;
+                const double dz = td[j + l] - base.d;
+                const double inside = (dx*dx + dy*dy + dz*dz <= base.radius_pow2) ? 1.0 : 0.0;
+                lane[l] += inside * stress_dt[j + l];
+            }
+        }
+        for (; j < count; j++)
+        {
+            const double dx = tv[j] - base.v;
+            const double dy = ta[j] - base.a;
+            const double dz = td[j] - base.d;
+            const double inside = (dx*dx + dy*dy + dz*dz <= base.radius_pow2) ? 1.0 : 0.0;
+            lane[0] += inside * stress_dt[j];
+        }
+        return (lane[0] + lane[1]) + (lane[2] + lane[3]);
+    }
+}
+
+BaselineColumns EGO_compute_baselines(const compute_in& user_in)
+{
+    const weight w = user_in.weights.value_or(weight{});
+    const variable vars = user_in.variables.value_or(variable{});
+
+    std::vector<EGO_axis> baselines = user_in.baselines;
+    if (baselines.empty())
+        baselines.push_back(user_in.emotion_base.value_or(EGO_axis{}));
+
+    const std::size_t count = baselines.size();
+    std::vector<Baseline_Test> tests(count);
+    for (std::size_t b = 0; b < count; b++)
+    {
+        const Interval_Params p = make_interval_params(baselines[b], w, vars);
+        tests[b] = Baseline_Test{p.baseline_v, p.baseline_a, p.baseline_d, p.radius_pow2};
+    }
+
+    // baseline-free kernel: a negative radius never dampens, so stress is stress * dt
+    const Interval_Params undamped = make_interval_params(EGO_axis{VADPoint{0.0, 0.0, 0.0, 0.0}, -1.0}, w, vars);
+
+    // shared pass + one distance test per baseline, tile by tile
+    const HistorySpan history = user_in.history_span();
+    double total_stress = 0, total_reward = 0;
+    std::vector<double> inside(count, 0.0);
+
+    double tv[TILE], ta[TILE], td[TILE], stress_dt[TILE];
+    for (std::size_t begin = 1; begin < history.size; begin += TILE)
+    {
+        const std::size_t end = std::min(history.size, begin + TILE);
+        const std::size_t n = end - begin;
+
+        for (std::size_t j = 0; j < n; j++)
+        {
+            const std::size_t i = begin + j;
+            tv[j] = history.v_at(i);
+            ta[j] = history.a_at(i);
+            td[j] = history.d_at(i);
+
+            Interval_Terms terms = get_sample_terms(tv[j], ta[j], td[j], history.timestamp_at(i) - history.timestamp_at(i - 1), undamped);
+            stress_dt[j] = terms.stress;
+            total_stress += terms.stress;
+            total_reward += terms.reward;
+        }
+
+        for (std::size_t b = 0; b < count; b++)
+            inside[b] += inside_stress(tests[b], tv, ta, td, stress_dt, n);
+    }
+
+    // per baseline: O(1) instant part + the dampened integral
+    BaselineColumns out;
+    out.instant_stress.resize(count);
+    out.deviation.resize(count);
+    out.cumulative_stress.resize(count);
+    out.cumulative_stress_ratio.resize(count);
+    out.cumulative_reward = total_reward;
+
+    const VADPoint& current = user_in.current;
+    for (std::size_t b = 0; b < count; b++)
+    {
+        const Interval_Params p = make_interval_params(baselines[b], w, vars);
+
+        // dt = 1 turns the interval term back into the instant value
+        out.instant_stress[b] = get_sample_terms(current.v, current.a, current.d, 1.0, p).stress;
+
+        const double dx = current.v - p.baseline_v, dy = current.a - p.baseline_a, dz = current.d - p.baseline_d;
+        out.deviation[b] = std::sqrt(dx*dx + dy*dy + dz*dz);
+
+        const double stress = total_stress - (1.0 - vars.dampening_factor) * inside[b];
+        out.cumulative_stress[b] = stress;
+        out.cumulative_stress_ratio[b] = make_cumulative_metrics(VAD_ave{}, stress, total_reward).stress_ratio;
+    }
+    return out;
+}
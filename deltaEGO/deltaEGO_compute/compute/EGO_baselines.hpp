@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "EGO_compute.hpp"
+
+// return struct------------------------------------------------------------
+// row k = compute_in.baselines[k]
+struct BaselineColumns
+{
+    std::vector<double> instant_stress;
+    std::vector<double> deviation;
+    std::vector<double> cumulative_stress;
+    std::vector<double> cumulative_stress_ratio;    // stress / (stress + reward)
+
+    double cumulative_reward = 0;   // same for every baseline
+
+    std::size_t size() const { return instant_stress.size(); }
+};
+// return struct------------------------------------------------------------
+
+/*
+ * Stress, deviation and cumulative stress of one history against every EGO_axis in
+ * user_in.baselines (emotion_base alone if the list is empty), in one traversal.
+ * Only dampening depends on the baseline, so per sample
+ *  - stress * dt and reward * dt are computed once,
+ *  - each baseline adds one distance^2 test: cumulative_stress = total - (1 - dampening) * inside.
+ * Same numbers as EGO_compute with emotion_base = baselines[k] (lifetime cumulative).
+ * Time complexity: O(n * (1 + baselines)), the per-baseline part is the distance test only
+ * Space complexity: O(baselines)
+ */
+BaselineColumns EGO_compute_baselines(const compute_in& user_in);
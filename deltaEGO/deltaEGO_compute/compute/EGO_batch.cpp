@@ -0,0 +1,112 @@
+#include "EGO_batch.hpp"
+#include "EGO_parallel.hpp"
+#include <stdexcept>
+
+// AnalysisColumns ---------------------------------------------------------------------
+void AnalysisColumns::resize(std::size_t n)
+{
+    for (auto* column : {&instant_stress, &instant_reward, &instant_ratio_total,
+                         &instant_stress_ratio, &instant_reward_ratio, &deviation,
+                         &delta_v, &delta_a, &delta_d, &affective_lability,
+                         &average_x, &average_y, &average_z, &average_radius,
+                         &cumulative_stress, &cumulative_reward, &cumulative_total,
+                         &cumulative_stress_ratio, &cumulative_reward_ratio})
+    {
+        column->assign(n, 0.0);
+    }
+}
+
+void AnalysisColumns::set(std::size_t i, const AnalysisResult& result)
+{
+    instant_stress[i] = result.instant.stress;
+    instant_reward[i] = result.instant.reward;
+    instant_ratio_total[i] = result.instant.ratio_total;
+    instant_stress_ratio[i] = result.instant.stress_ratio;
+    instant_reward_ratio[i] = result.instant.reward_ratio;
+    deviation[i] = result.instant.deviation;
+
+    delta_v[i] = result.dynamics.delta.v;
+    delta_a[i] = result.dynamics.delta.a;
+    delta_d[i] = result.dynamics.delta.d;
+    affective_lability[i] = result.dynamics.affective_lability;
+
+    average_x[i] = result.cumulative.average_area.x;
+    average_y[i] = result.cumulative.average_area.y;
+    average_z[i] = result.cumulative.average_area.z;
+    average_radius[i] = result.cumulative.average_area.radius;
+    cumulative_stress[i] = result.cumulative.stress;
+    cumulative_reward[i] = result.cumulative.reward;
+    cumulative_total[i] = result.cumulative.total;
+    cumulative_stress_ratio[i] = result.cumulative.stress_ratio;
+    cumulative_reward_ratio[i] = result.cumulative.reward_ratio;
+}
+// AnalysisColumns ---------------------------------------------------------------------
+
+
+/*
+ * This function analyzes every session in parallel.
+ * Each worker runs EGO_compute_sync, so no thread is spawned per session.
+ * Time complexity: O(total history / threads)
+ * Space complexity: O(sessions)
+ */
+AnalysisColumns EGO_compute_batch(const std::vector<compute_in>& sessions, unsigned int threads, math_precision precision)
+{
+    AnalysisColumns out;
+    out.resize(sessions.size());
+
+    parallel_for(sessions.size(), threads, [&](std::size_t i)
+    {
+        out.set(i, EGO_compute_sync(sessions[i], precision));
+    });
+
+    return out;
+}
+
+/*
+ * This function analyzes concatenated histories (see history_columns_in).
+ * Each session is a HistorySpan into the shared columns, nothing is copied.
+ * Time complexity: O(total history / threads)
+ * Space complexity: O(sessions)
+ */
+AnalysisColumns EGO_compute_batch_columnar(const history_columns_in& columns, unsigned int threads,
+                                           math_precision precision)
+{
+    const std::size_t sessions = columns.sessions;
+
+    // check offsets before going parallel
+    if (sessions > 0)
+    {
+        if (!columns.offsets || !columns.v || !columns.a || !columns.d || !columns.timestamp)
+            throw std::invalid_argument("history columns and offsets must not be null");
+
+        if (columns.offsets[0] != 0)
+            throw std::invalid_argument("offsets must start at 0");
+
+        for (std::size_t i = 0; i < sessions; i++)
+        {
+            if (columns.offsets[i + 1] < columns.offsets[i])
+                throw std::invalid_argument("offsets must be non-decreasing");
+        }
+    }
+
+    const HistorySpan all{columns.v, columns.a, columns.d, columns.timestamp,
+                          (sessions > 0) ? static_cast<std::size_t>(columns.offsets[sessions]) : 0};
+
+    AnalysisColumns out;
+    out.resize(sessions);
+
+    parallel_for(sessions, threads, [&](std::size_t i)
+    {
+        const HistorySpan history = all.sub(static_cast<std::size_t>(columns.offsets[i]),
+                                            static_cast<std::size_t>(columns.offsets[i + 1]));
+
+        const std::size_t n = history.size;
+        const VADPoint current = (n > 0) ? history.point(n - 1) : VADPoint{0.0, 0.0, 0.0, 0.0};
+        const std::optional<VADPoint> prev = (n > 1) ? std::optional<VADPoint>(history.point(n - 2)) : std::nullopt;
+
+        out.set(i, EGO_compute_sync(current, history, prev,
+                                    columns.emotion_base, columns.variables, columns.weights, precision));
+    });
+
+    return out;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "EGO_compute.hpp"
+
+// return struct------------------------------------------------------------
+/*
+ * Column-major AnalysisResult for many sessions.
+ * Row i of every column belongs to session i.
+ */
+struct AnalysisColumns
+{
+    // InstantMetrics
+    std::vector<double> instant_stress;
+    std::vector<double> instant_reward;
+    std::vector<double> instant_ratio_total;
+    std::vector<double> instant_stress_ratio;
+    std::vector<double> instant_reward_ratio;
+    std::vector<double> deviation;
+
+    // DynamicMetrics
+    std::vector<double> delta_v;
+    std::vector<double> delta_a;
+    std::vector<double> delta_d;
+    std::vector<double> affective_lability;
+
+    // CumulativeMetrics
+    std::vector<double> average_x;
+    std::vector<double> average_y;
+    std::vector<double> average_z;
+    std::vector<double> average_radius;
+    std::vector<double> cumulative_stress;
+    std::vector<double> cumulative_reward;
+    std::vector<double> cumulative_total;
+    std::vector<double> cumulative_stress_ratio;
+    std::vector<double> cumulative_reward_ratio;
+
+    void resize(std::size_t n);
+    void set(std::size_t i, const AnalysisResult& result);
+    std::size_t size() const { return instant_stress.size(); }
+};
+// return struct------------------------------------------------------------
+
+// input struct-------------------------------------------------------------
+/*
+ * Histories of many sessions concatenated into flat arrays.
+ * Session i owns samples [offsets[i], offsets[i+1]), so offsets has sessions + 1 entries.
+ * The last sample of a session is its `current`, the one before is its `prev`
+ * (same convention as deltaEGO.analize_VAD).
+ */
+struct history_columns_in
+{
+    const double* v = nullptr;
+    const double* a = nullptr;
+    const double* d = nullptr;
+    const double* timestamp = nullptr;
+    const std::int64_t* offsets = nullptr;
+    std::size_t sessions = 0;
+
+    std::optional<EGO_axis> emotion_base;
+    std::optional<variable> variables;
+    std::optional<weight> weights;
+};
+// input struct-------------------------------------------------------------
+
+// main --------------------------------------------------------------------
+// threads == 0 -> every hardware thread
+// precision == fast uses the branch-free atan2 / exp of EGO_fastmath.hpp for the lability column
+AnalysisColumns EGO_compute_batch(const std::vector<compute_in>& sessions, unsigned int threads = 0,
+                                  math_precision precision = math_precision::exact);
+AnalysisColumns EGO_compute_batch_columnar(const history_columns_in& columns, unsigned int threads = 0,
+                                           math_precision precision = math_precision::exact);
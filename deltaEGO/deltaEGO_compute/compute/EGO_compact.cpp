@@ -0,0 +1,288 @@
+#include "EGO_compact.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// SummaryBlock --------------------------------------------------------------------
+/*
+ * First-order move of the distance sum from ref to c, kept inside the
+ * Lipschitz band [dist_sum - n|c - ref|, dist_sum + n|c - ref|].
+ * Time complexity: O(1)
+ */
+double SummaryBlock::distance_sum(double cx, double cy, double cz, double& error) const
+{
+    const double dx = cx - this->ref_v, dy = cy - this->ref_a, dz = cz - this->ref_d;
+    const double band = static_cast<double>(this->count) * std::sqrt(dx*dx + dy*dy + dz*dz);
+
+    const double moved = this->dist_sum + this->grad_v * dx + this->grad_a * dy + this->grad_d * dz;
+    error = this->dist_error + 2.0 * band;
+    return std::min(this->dist_sum + band, std::max(this->dist_sum - band, moved));
+}
+
+// older block absorbs the newer one, the merged reference is the newer one's
+void SummaryBlock::merge(const SummaryBlock& newer)
+{
+    double moved_error = 0;
+    const double moved = this->distance_sum(newer.ref_v, newer.ref_a, newer.ref_d, moved_error);
+
+    this->dist_sum = moved + newer.dist_sum;
+    this->dist_error = moved_error + newer.dist_error;
+    this->grad_v += newer.grad_v;   // gradient of the older half is from its old ref: first order only
+    this->grad_a += newer.grad_a;
+    this->grad_d += newer.grad_d;
+    this->ref_v = newer.ref_v;
+    this->ref_a = newer.ref_a;
+    this->ref_d = newer.ref_d;
+
+    this->count += newer.count;
+    this->t_end = newer.t_end;
+    this->sum_v += newer.sum_v;
+    this->sum_a += newer.sum_a;
+    this->sum_d += newer.sum_d;
+    this->stress += newer.stress;
+    this->reward += newer.reward;
+}
+
+// CompactHistory ------------------------------------------------------------------
+CompactHistory::CompactHistory(const compaction_policy& policy, const EGO_axis& base, const weight& w, const variable& v)
+    : settings(policy), base(base), w(w), vars(v), params(make_interval_params(base, w, v))
+{
+    if (policy.recent < 2)
+        throw std::invalid_argument("compaction_policy.recent must be at least 2");
+    if (policy.block_size == 0)
+        throw std::invalid_argument("compaction_policy.block_size must be positive");
+    if (policy.max_blocks < 2)
+        throw std::invalid_argument("compaction_policy.max_blocks must be at least 2");
+}
+
+void CompactHistory::push(double V, double A, double D, double ts)
+{
+    this->v.push_back(V);
+    this->a.push_back(A);
+    this->d.push_back(D);
+    this->timestamp.push_back(ts);
+    this->total_v += V;
+    this->total_a += A;
+    this->total_d += D;
+
+    // fold a whole block at once so the erase below is paid once per block_size pushes
+    if (this->v.size() >= this->settings.recent + this->settings.block_size)
+        this->fold_oldest();
+}
+
+/*
+ * Folds the oldest block_size recent samples into a new block,
+ * with the current overall center as the block's radius reference.
+ * Time complexity: O(recent)
+ */
+void CompactHistory::fold_oldest()
+{
+    const std::size_t count = this->settings.block_size;
+    const VAD_ave ref = this->center();
+
+    SummaryBlock block;
+    block.count = count;
+    block.t_begin = this->timestamp[0];
+    block.t_end = this->timestamp[count - 1];
+    block.ref_v = ref.x;
+    block.ref_a = ref.y;
+    block.ref_d = ref.z;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        block.sum_v += this->v[i];
+        block.sum_a += this->a[i];
+        block.sum_d += this->d[i];
+
+        // d/dref |x - ref| = (ref - x) / |x - ref|
+        const double dx = ref.x - this->v[i], dy = ref.y - this->a[i], dz = ref.z - this->d[i];
+        const double dist = std::sqrt(dx*dx + dy*dy + dz*dz);
+        block.dist_sum += dist;
+        if (dist > 0)
+        {
+            block.grad_v += dx / dist;
+            block.grad_a += dy / dist;
+            block.grad_d += dz / dist;
+        }
+
+        // the very first sample has no interval
+        const bool has_prev = (i > 0) || !this->summary.empty();
+        if (has_prev)
+        {
+            const double prev_t = (i > 0) ? this->timestamp[i - 1] : this->summary.back().t_end;
+            Interval_Terms terms = get_sample_terms(this->v[i], this->a[i], this->d[i], this->timestamp[i] - prev_t, this->params);
+            block.stress += terms.stress;
+            block.reward += terms.reward;
+        }
+    }
+
+    this->summary.push_back(block);
+    this->folded += count;
+
+    this->v.erase(this->v.begin(), this->v.begin() + count);
+    this->a.erase(this->a.begin(), this->a.begin() + count);
+    this->d.erase(this->d.begin(), this->d.begin() + count);
+    this->timestamp.erase(this->timestamp.begin(), this->timestamp.begin() + count);
+
+    if (this->summary.size() > this->settings.max_blocks)
+        this->merge_blocks();
+}
+
+/*
+ * Merges the oldest pair of neighbours with equal counts (binary-counter style),
+ * so block size grows with age: old turns get coarse, recent ones stay fine.
+ * If no pair is equal, the neighbours with the smallest combined count merge.
+ * Time complexity: O(max_blocks)
+ */
+void CompactHistory::merge_blocks()
+{
+    std::size_t pick = 0;
+    std::size_t best = static_cast<std::size_t>(-1);
+    for (std::size_t i = 0; i + 1 < this->summary.size(); i++)
+    {
+        const std::size_t left = this->summary[i].count, right = this->summary[i + 1].count;
+        if (left == right)
+        {
+            pick = i;
+            break;
+        }
+        if (left + right < best)
+        {
+            best = left + right;
+            pick = i;
+        }
+    }
+
+    this->summary[pick].merge(this->summary[pick + 1]);
+    this->summary.erase(this->summary.begin() + pick + 1);
+}
+
+HistorySpan CompactHistory::recent() const
+{
+    return HistorySpan{this->v.data(), this->a.data(), this->d.data(), this->timestamp.data(), this->v.size(), 1};
+}
+
+VAD_ave CompactHistory::center() const
+{
+    if (this->empty())
+        return VAD_ave{0.0, 0.0, 0.0, 0.0};
+
+    const double n = static_cast<double>(this->size());
+    return VAD_ave{this->total_v / n, this->total_a / n, this->total_d / n, 0.0};
+}
+
+void CompactHistory::clear()
+{
+    this->summary.clear();
+    this->folded = 0;
+    this->total_v = this->total_a = this->total_d = 0;
+    this->v.clear();
+    this->a.clear();
+    this->d.clear();
+    this->timestamp.clear();
+}
+
+// metrics -------------------------------------------------------------------------
+/*
+ * Center is exact; block radii use the moved distance sums (see EGO_compact.hpp).
+ * Time complexity: O(blocks + recent)
+ */
+VAD_ave calculate_average(const CompactHistory& history)
+{
+    if (history.empty())
+        return VAD_ave{0.0, 0.0, 0.0, 0.05};
+
+    const VAD_ave c = history.center();
+
+    double r = 0, error = 0;
+    for (const SummaryBlock& block : history.blocks())
+        r += block.distance_sum(c.x, c.y, c.z, error);
+
+    const HistorySpan recent = history.recent();
+    for (std::size_t i = 0; i < recent.size; i++)
+    {
+        const double dx = c.x - recent.v_at(i);
+        const double dy = c.y - recent.a_at(i);
+        const double dz = c.z - recent.d_at(i);
+        r += std::sqrt(dx*dx + dy*dy + dz*dz);
+    }
+
+    return VAD_ave{c.x, c.y, c.z, r / static_cast<double>(history.size())};
+}
+
+/*
+ * Lifetime cumulative metrics: block integrals + the recent intervals
+ * (the first recent interval starts at the last block's t_end).
+ * Time complexity: O(blocks + recent)
+ */
+CumulativeMetrics calculate_cumulative(const CompactHistory& history)
+{
+    const Interval_Params params = make_interval_params(history.emotion_base(), history.weights(), history.variables());
+
+    double stress = 0, reward = 0;
+    for (const SummaryBlock& block : history.blocks())
+    {
+        stress += block.stress;
+        reward += block.reward;
+    }
+
+    const HistorySpan recent = history.recent();
+    for (std::size_t i = 0; i < recent.size; i++)
+    {
+        if (i == 0 && history.blocks().empty())
+            continue;
+
+        const double prev_t = (i > 0) ? recent.timestamp_at(i - 1) : history.blocks().back().t_end;
+        Interval_Terms terms = get_sample_terms(recent.v_at(i), recent.a_at(i), recent.d_at(i),
+                                                recent.timestamp_at(i) - prev_t, params);
+        stress += terms.stress;
+        reward += terms.reward;
+    }
+
+    return make_cumulative_metrics(calculate_average(history), stress, reward);
+}
+
+/*
+ * Upper bound of |approximate radius - exact radius|.
+ * Zero while nothing has been folded.
+ * Time complexity: O(blocks)
+ */
+double radius_error_bound(const CompactHistory& history)
+{
+    if (history.blocks().empty())
+        return 0.0;
+
+    const VAD_ave c = history.center();
+
+    double bound = 0;
+    for (const SummaryBlock& block : history.blocks())
+    {
+        double error = 0;
+        block.distance_sum(c.x, c.y, c.z, error);
+        bound += error;
+    }
+    return bound / static_cast<double>(history.size());
+}
+
+/*
+ * Instant / dynamics come from the last two samples (always full resolution),
+ * cumulative from calculate_cumulative.
+ * Time complexity: O(blocks + recent)
+ */
+AnalysisResult EGO_compute(const CompactHistory& history)
+{
+    const HistorySpan recent = history.recent();
+    if (recent.size == 0)
+        throw std::invalid_argument("CompactHistory is empty");
+
+    const std::size_t n = recent.size;
+    std::optional<VADPoint> prev;
+    if (n > 1)
+        prev = recent.point(n - 2);
+
+    // history of size <= 2: the O(n) part is trivial and gets replaced below
+    AnalysisResult result = EGO_compute_sync(recent.point(n - 1), recent.sub(n > 1 ? n - 2 : 0, n), prev,
+                                             history.emotion_base(), history.variables(), history.weights());
+    result.cumulative = calculate_cumulative(history);
+    return result;
+}
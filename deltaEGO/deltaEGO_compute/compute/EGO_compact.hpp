@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "EGO_compute.hpp"
+#include "EGO_kernel.hpp"
+
+/*
+ * Memory-bounded history.
+ * The newest samples stay at full resolution; older ones are folded into
+ * SummaryBlocks that keep only what the lifetime cumulative metrics need:
+ * count, time span, moment sums of v/a/d, the stress / reward integrals, and
+ * the distance sum to a reference point for the radius.
+ *
+ * Exactness (compared with EGO_compute on the full history):
+ *  - center, stress and reward are exact (up to summation order),
+ *  - the mean radius is approximated. A block stores f(r) = sum |x - r| and its gradient
+ *    at r = the overall center when it was folded. Queried at the current center c,
+ *    f(c) ~= f(r) + grad . (c - r). Since f is 1-Lipschitz per sample, the error is at most
+ *    2 * n_b * |c - r| (plus what earlier merges added), and the overall center moves less
+ *    and less as history grows. radius_error_bound() returns the sum of those bounds / n.
+ * Stress / reward integrals are baked into blocks with the Interval_Params given
+ * at construction; changing weights later needs a fresh CompactHistory.
+ */
+
+// one folded run of consecutive samples
+struct SummaryBlock
+{
+    std::size_t count = 0;
+    double t_begin = 0;
+    double t_end = 0;
+    double sum_v = 0, sum_a = 0, sum_d = 0;
+    double stress = 0, reward = 0;  // integrals of the intervals that end inside the block
+
+    // radius: sum |x - ref| and its gradient with respect to ref
+    double ref_v = 0, ref_a = 0, ref_d = 0;
+    double dist_sum = 0;
+    double grad_v = 0, grad_a = 0, grad_d = 0;
+    double dist_error = 0;          // bound on |dist_sum - exact|, 0 until blocks merge
+
+    // estimated sum |x - c| over the block's samples; `error` gets its bound
+    double distance_sum(double cx, double cy, double cz, double& error) const;
+    void merge(const SummaryBlock& newer);
+};
+
+// input struct-------------------------------------------------------------
+struct compaction_policy
+{
+    std::size_t recent = 1024;      // samples kept at full resolution (at least 2)
+    std::size_t block_size = 64;    // samples folded into one new block
+    std::size_t max_blocks = 128;   // above this, the oldest equal-sized neighbours merge
+};
+// input struct-------------------------------------------------------------
+
+class CompactHistory
+{
+    public:
+    CompactHistory(const compaction_policy& policy = compaction_policy{},
+                   const EGO_axis& base = EGO_axis{},
+                   const weight& w = weight{},
+                   const variable& v = variable{});
+
+    // Time complexity: amortized O(1 + (recent + max_blocks) / block_size)
+    void push(double V, double A, double D, double timestamp);
+    void push(const VADPoint& point) { this->push(point.v, point.a, point.d, point.timestamp); }
+    void clear();
+
+    std::size_t size() const { return this->folded + this->v.size(); }   // every sample ever pushed
+    bool empty() const { return this->size() == 0; }
+    const std::vector<SummaryBlock>& blocks() const { return this->summary; }
+    HistorySpan recent() const;   // full-resolution tail
+    VAD_ave center() const;       // exact center of every sample (radius left 0), O(1)
+
+    const compaction_policy& policy() const { return this->settings; }
+    const EGO_axis& emotion_base() const { return this->base; }
+    const weight& weights() const { return this->w; }
+    const variable& variables() const { return this->vars; }
+
+    private:
+    void fold_oldest();
+    void merge_blocks();
+
+    compaction_policy settings;
+    EGO_axis base;
+    weight w;
+    variable vars;
+    Interval_Params params;
+
+    std::vector<SummaryBlock> summary;  // oldest first
+    std::size_t folded = 0;             // samples inside summary
+    double total_v = 0, total_a = 0, total_d = 0;
+
+    std::vector<double> v, a, d, timestamp;   // recent samples, oldest first
+};
+
+// same meaning as the HistorySpan versions, computed from blocks + recent samples
+// Time complexity: O(blocks + recent)
+VAD_ave calculate_average(const CompactHistory& history);
+CumulativeMetrics calculate_cumulative(const CompactHistory& history);
+double radius_error_bound(const CompactHistory& history);
+
+// full analysis with the newest sample as current and the one before as prev
+AnalysisResult EGO_compute(const CompactHistory& history);
@@ -1,412 +1,768 @@
-#include "EGO_compute.hpp"
-// TODO: do oposite of now
-
-// struct ---------------------------------------------------------------------------
-struct O1_Tasks_Result 
-{
-    VADPoint delta;
-    double instant_stress;
-    double instant_reward;
-    double instant_ratio_total;
-    double instant_stress_ratio;
-    double instant_reward_ratio;
-    double affective_lability;
-    double deviation;
-};
-
-struct Ratio
-{
-    double stress_raw;
-    double reward_raw;
-    double ratio_total;
-    double stress_ratio;
-    double reward_ratio;
-};
-// struct ---------------------------------------------------------------------------
-
-
-// inline function ------------------------------------------------------------------
-/*
- * This function returns Euclidian distance between points in 3d area.
- * Time complexity: O(1)
- * Space complexity: O(1)
- */
-inline double get_distance(const VADPoint& a, const VADPoint& b)
-{
-    return std::sqrt((a.v - b.v)*(a.v - b.v) + (a.a - b.a)*(a.a - b.a) + (a.d - b.d)*(a.d - b.d));
-}
-inline double sigmoid(double x)
-{
-    if (x >= 0) 
-    {
-        double e = std::exp(-x);
-        return 1.0 / (1.0 + e);
-    } 
-    else 
-    {
-        double e = std::exp(x);
-        return e / (1.0 + e);
-    }
-}
-/**
- * This function analizes ratio.
- * Time complexity = O(1)
- * Space complexity = O(1)
- */
-Ratio inline get_stress_reward_ratio(const double& stress, const double& dopamine)
-{
-    double total = stress + dopamine;
-    double ratio_stress = 0.0;
-    double ratio_reward = 0.0;
-
-    // if it tries to devide with 0
-    if (total > 1e-9)
-    {
-        ratio_stress = stress / total;
-        ratio_reward = dopamine / total;
-    }
-
-    return Ratio{stress, dopamine, total, ratio_stress, ratio_reward};
-}
-// inline function ------------------------------------------------------------------
-
-
-// O(1) ------------------------------------------------------------------------------
-/*
- * This function returns delta value of current and prev emotion
- * Time complexity: O(1)
- * Space complexity: O(1)
- */
-VADPoint calculate_delta(const VADPoint& prev, const VADPoint& current)
-{
-    double dt = current.timestamp - prev.timestamp;
-
-    if (dt <= 0) 
-        dt = 1.0;
-
-    return {
-        (current.v - prev.v) / dt,
-        (current.a - prev.a) / dt,
-        (current.d - prev.d) / dt,
-        current.timestamp
-    };
-}
-
-/*
- * This function returns instant stress level
- * Time complexity: O(1)
- * Space complexity: O(1)
- */
-double calculate_instant_stress(const VADPoint& current, 
-                                const VADPoint& baseline, 
-                                double stabilityRadius, 
-                                double weightA_stress, 
-                                double weightV_stress,
-                                double dampening_factor)
-{
-    double distance = get_distance(current, baseline);
-
-    // if emotion is in emotion stability area, level of stress will decrease
-    dampening_factor = (distance <= stabilityRadius) ? dampening_factor : 1.0;
-    
-    // stress from valance 
-    double stressV = weightV_stress * ((1.0 - current.v) / 2.0); 
-    // stress from arousal
-    double stressA = weightA_stress * current.a;
-
-    // total stress
-    double normal_stress = std::min(1.0, std::max(0.0, stressV + stressA));
-    
-    return normal_stress * dampening_factor;
-}
-
-/*
- * This function returns affective lability(emotional whiplash)
- * Used sigmoid
- * Time complexity: O(1)
- * Space complexity: O(1)
- */
-double calculate_affective_lability(const VADPoint& delta, const double& weight_k, const double& theta_0)
-{
-    // get Slope in 3d
-    double horizon_h = std::sqrt(delta.v*delta.v + delta.a*delta.a);
-    double theta = std::atan2(delta.d, horizon_h);
-    double z = weight_k * (theta - theta_0);
-
-    return sigmoid(z);
-}
-
-/*
- * This function returns a 'Reward Index'. Emulates dopamine
- * Based on High Valence (Pleasure) and High Arousal (Energy)
- * Time complexity: O(1)
- */
-double calculate_reward_index(const VADPoint& current, 
-                              double weightV_reward, 
-                              double weightA_reward)
-{
-    double rewardV = weightV_reward * ((current.v + 1.0) / 2.0);    
-    double rewardA = weightA_reward * current.a;
-
-    return std::min(1.0, std::max(0.0, rewardV + rewardA));
-}
-
-/*
- * This funtion calculate O(1) executions.
- * Time complexity: O(1)
- * Space complexity: O(1)
- */
-O1_Tasks_Result get_O1_functions_async(
-    const std::optional<VADPoint>& prev,
-    const VADPoint& current,
-    const VADPoint& baseline,
-    double stabilityRadius,
-    double weightA_stress,
-    double weightV_stress,
-    double weightV_reward,
-    double weightA_reward,
-    double dampening_factor,
-    double weight_k,
-    double theta_0)
-{
-    // delta
-    VADPoint delta_reval = (prev.has_value()) ? calculate_delta(prev.value(), current) : VADPoint{ 0.0, 0.0, 0.0, 0.0 };
-
-    // Instant Stress
-    double instant_stress_reval = calculate_instant_stress(
-        current, baseline, stabilityRadius, weightA_stress, weightV_stress, dampening_factor);
-
-    // Affective Lability
-    double affective_lability_reval = calculate_affective_lability(
-        delta_reval, weight_k, theta_0);
-    
-    // Instant reward
-    double instant_reward_reval = calculate_reward_index(current, weightV_reward, weightA_reward);
-
-    // ratio
-    Ratio ratio = get_stress_reward_ratio(instant_stress_reval, instant_reward_reval);
-
-    // deviation
-    double deviation = get_distance(current, baseline);
-
-    return O1_Tasks_Result{ 
-        delta_reval, 
-        instant_stress_reval, 
-        instant_reward_reval,      
-        ratio.ratio_total, 
-        ratio.stress_ratio, 
-        ratio.reward_ratio, 
-        affective_lability_reval, 
-        deviation 
-    };    
-}    
-// O(1) ------------------------------------------------------------------------------
-
-
-
-// O(n) ------------------------------------------------------------------------------
-/*
- * This funtion returns average emotion area based on history.
- * History must be up-to-date for accuracy.
- * Time complexity: O(n) = 2T(n)
- * Space complexity: O(1)
- */ 
-VAD_ave calculate_average(const std::vector<VADPoint>& history)
-{
-    int history_size = static_cast<int>(history.size());
-    // if history is empty
-    if(history_size == 0)
-    {
-        return VAD_ave{0.0, 0.0, 0.0, 0.05};
-    }    
-    
-    // calculate average emotion's center
-    double v = 0, a = 0, d = 0;
-    for(const auto& element: history)
-    {
-        v += element.v;
-        a += element.a;
-        d += element.d;
-    }    
-    v /= history_size; a /= history_size; d /= history_size;
-    
-    // calculate radius of average emotion
-    VADPoint average_center{v,a,d,0.0};
-    double r = 0;
-    for(const auto& element: history)
-    {
-        r += get_distance(average_center, element);
-    }    
-    r /= history_size;
-    
-    return VAD_ave{v,a,d,r};
-}    
-
-/*
- * This funtion returns cumulative stress with anti-diff
- * Time complexity: O(n) = T(n)
- * Space complexity: O(1)
- */ 
-double calculate_cumulative_stress(const std::vector<VADPoint>& history, 
-                                    const VADPoint& baseline, 
-                                    const double& stabilityRadius,
-                                    const double& weightA_stress, 
-                                    const double& weightV_stress,
-                                    const double& dampening_factor)                                    
-{
-    size_t history_size = history.size();
-
-    // if sample is too small
-    if (history_size < 2) 
-        return 0.0;
-
-    double cumulative_stress = 0.0;
-    for(size_t i = 1; i < history_size; i++)
-    {
-        const auto& current = history[i];
-        const auto& prev = history[i-1];
-
-        double dt = current.timestamp - prev.timestamp;
-        if (dt <= 0) 
-            dt = 0.1;
-        
-        // get interval's stress and anti-diff
-        double instant_stress = calculate_instant_stress(current, 
-                                                        baseline, 
-                                                        stabilityRadius, 
-                                                        weightA_stress, 
-                                                        weightV_stress,
-                                                        dampening_factor);
-        cumulative_stress += instant_stress * dt;
-    }
-
-    return cumulative_stress;
-}
-/*
- * This funtion returns cumulative reward with anti-diff
- * Time complexity: O(n) = T(n)
- * Space complexity: O(1)
- */
-double calculate_cumulative_reward(const std::vector<VADPoint>& history, 
-                                   const double& weightV_reward, 
-                                   const double& weightA_reward)
-{
-    size_t history_size = history.size();
-
-    // if sample is too small
-    if (history_size < 2) 
-        return 0.0;
-
-    double cumulative_reward = 0.0;
-    for(size_t i = 1; i < history_size; i++)
-    {
-        const auto& current = history[i];
-        const auto& prev = history[i-1];
-
-        double dt = current.timestamp - prev.timestamp;
-        if (dt <= 0) 
-            dt = 0.1;
-        
-        double instant_reward = calculate_reward_index(current, 
-                                                         weightV_reward, 
-                                                         weightA_reward);
-        
-        cumulative_reward += instant_reward * dt;
-    }
-
-    return cumulative_reward;
-}
-/**
- * This function is package of get_cumulative_data, stress, and reward.
- * This will run as multithreading
- * Time complexity = O(n) = T(n) + T(n) + T(1)
- * Space complexity = O(1)
- */
-Ratio get_Tn_functions_async(const std::vector<VADPoint>& history, 
-                                        const VADPoint& baseline, 
-                                        const double& stabilityRadius,
-                                        const double& weightA_stress, 
-                                        const double& weightV_stress,
-                                        const double& dampening_factor,
-                                        const double& weightV_reward, 
-                                        const double& weightA_reward)
-{
-    double cumcul_stress = calculate_cumulative_stress(history, baseline, stabilityRadius, weightA_stress, weightV_stress, dampening_factor);
-    double cumcul_reward = calculate_cumulative_reward(history, weightV_reward, weightA_reward);
-
-    return get_stress_reward_ratio(cumcul_stress, cumcul_reward);
-}
-// O(n) ------------------------------------------------------------------------------
-
-
-// analize 
-AnalysisResult EGO_compute(const compute_in& user_in)
-{
-    EGO_axis base = user_in.emotion_base.value_or(EGO_axis{});
-    weight w = user_in.weights.value_or(weight{});
-    variable v = user_in.variables.value_or(variable{});
-
-    // thread executes O(n) = 2T(n) task
-    auto thread_average = std::async(std::launch::async,
-        calculate_average,
-        std::ref(user_in.history)
-    );
-
-    // thread executes O(n) = T(n) + T(n) + T(1)
-    auto thread_Tn_funcs = std::async(std::launch::async,
-        get_Tn_functions_async,
-        std::ref(user_in.history),
-        std::ref(base.baseline),
-        base.stabilityRadius,
-        w.weightA_stress,
-        w.weightV_stress,
-        v.dampening_factor,
-        w.weightV_reward,
-        w.weightA_reward
-    );
-
-    // thread executes O(1) bundle
-    auto thread_O1_funcs = std::async(std::launch::async,
-        get_O1_functions_async,
-        std::ref(user_in.prev),
-        std::ref(user_in.current),
-        std::ref(base.baseline),
-        base.stabilityRadius,
-        w.weightA_stress,
-        w.weightV_stress,
-        w.weightV_reward,
-        w.weightA_reward,
-        v.dampening_factor,
-        w.weight_k,
-        v.theta_0
-    );
-
-    // get result from threads
-    VAD_ave average_result =  thread_average.get();
-    Ratio n_results = thread_Tn_funcs.get();
-    O1_Tasks_Result o1_results = thread_O1_funcs.get();
-
-    // build result
-    AnalysisResult final_result;
-    // InstantMetrics
-    final_result.instant.stress = o1_results.instant_stress;
-    final_result.instant.reward = o1_results.instant_reward;
-    final_result.instant.ratio_total = o1_results.instant_ratio_total;
-    final_result.instant.stress_ratio = o1_results.instant_stress_ratio;
-    final_result.instant.reward_ratio = o1_results.instant_reward_ratio;
-    final_result.instant.deviation = o1_results.deviation;
-
-    // DynamicMetrics
-    final_result.dynamics.delta = o1_results.delta;
-    final_result.dynamics.affective_lability = o1_results.affective_lability;
-
-    // CumulativeMetrics
-    final_result.cumulative.average_area = average_result;
-    final_result.cumulative.stress = n_results.stress_raw;
-    final_result.cumulative.reward = n_results.reward_raw;
-    final_result.cumulative.total = n_results.ratio_total;
-    final_result.cumulative.stress_ratio = n_results.stress_ratio;
-    final_result.cumulative.reward_ratio = n_results.reward_ratio;
-
-    return final_result;
+#include "EGO_compute.hpp"
+#include "EGO_kernel.hpp"
+#include "EGO_model.hpp"
+#include "EGO_fastmath.hpp"
+#include "EGO_window.hpp"
+#include "EGO_resample.hpp"
+#include "EGO_parallel.hpp"
+#include <stdexcept>
+// TODO: do oposite of now
+
+// struct ---------------------------------------------------------------------------
+struct Ratio
+{
+    double stress_raw;
+    double reward_raw;
+    double ratio_total;
+    double stress_ratio;
+    double reward_ratio;
+};
+
+struct History_Tasks_Result
+{
+    VAD_ave average;
+    Ratio cumulative;
+    std::optional<LabilityMetrics> lability;
+};
+
+// struct ---------------------------------------------------------------------------
+
+
+// inline function ------------------------------------------------------------------
+/*
+ * This function returns Euclidian distance between points in 3d area.
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+inline double get_distance(const VADPoint& a, const VADPoint& b)
+{
+    return std::sqrt((a.v - b.v)*(a.v - b.v) + (a.a - b.a)*(a.a - b.a) + (a.d - b.d)*(a.d - b.d));
+}
+/**
+ * This function analizes ratio.
+ * Time complexity = O(1)
+ * Space complexity = O(1)
+ */
+Ratio inline get_stress_reward_ratio(const double& stress, const double& dopamine)
+{
+    double total = stress + dopamine;
+    double ratio_stress = 0.0;
+    double ratio_reward = 0.0;
+
+    // if it tries to devide with 0
+    if (total > 1e-9)
+    {
+        ratio_stress = stress / total;
+        ratio_reward = dopamine / total;
+    }
+
+    return Ratio{stress, dopamine, total, ratio_stress, ratio_reward};
+}
+// inline function ------------------------------------------------------------------
+
+
+// O(1) ------------------------------------------------------------------------------
+/*
+ * This function returns delta value of current and prev emotion
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+VADPoint calculate_delta(const VADPoint& prev, const VADPoint& current)
+{
+    double dt = current.timestamp - prev.timestamp;
+
+    if (dt <= 0) 
+        dt = 1.0;
+
+    return {
+        (current.v - prev.v) / dt,
+        (current.a - prev.a) / dt,
+        (current.d - prev.d) / dt,
+        current.timestamp
+    };
+}
+
+/*
+ * Slope of delta in 3d: angle between delta and the V-A plane.
+ * Time complexity: O(1)
+ */
+template <math_precision Precision>
+inline double delta_angle(const VADPoint& delta)
+{
+    double horizon_h = std::sqrt(delta.v*delta.v + delta.a*delta.a);
+    return math_atan2<Precision>(delta.d, horizon_h);
+}
+
+double calculate_delta_angle(const VADPoint& delta)
+{
+    return delta_angle<math_precision::exact>(delta);
+}
+
+/*
+ * calculate_affective_lability with the angle of delta already known.
+ * Time complexity: O(1)
+ */
+double calculate_affective_lability_at(double theta, double weight_k, double theta_0)
+{
+    double z = weight_k * (theta - theta_0);
+
+    return sigmoid(z);
+}
+
+/*
+ * This function returns affective lability(emotional whiplash)
+ * Used sigmoid
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+double calculate_affective_lability(const VADPoint& delta, const double& weight_k, const double& theta_0)
+{
+    return calculate_affective_lability_at(calculate_delta_angle(delta), weight_k, theta_0);
+}
+
+/*
+ * Delta, its angle and the deviation: the O(1) work that doesn't depend on weights / variables.
+ * precision picks atan2 for the angle (the deviation is a sqrt, exact in both modes).
+ * Time complexity: O(1)
+ */
+Instant_Shared calculate_instant_shared(const VADPoint& current,
+                                        const std::optional<VADPoint>& prev,
+                                        const VADPoint& baseline,
+                                        math_precision precision)
+{
+    Instant_Shared shared;
+    shared.delta = (prev.has_value()) ? calculate_delta(prev.value(), current) : VADPoint{ 0.0, 0.0, 0.0, 0.0 };
+    shared.theta = with_math_precision(precision, [&](auto mode)
+    {
+        return delta_angle<decltype(mode)::value>(shared.delta);
+    });
+    shared.deviation = get_distance(current, baseline);
+    return shared;
+}
+
+/*
+ * InstantMetrics + DynamicMetrics of one weights / variables set from the shared part.
+ * Stress / reward come from the same model the O(n) kernels pick (with_stress_model),
+ * so this is bitwise the O(1) half of EGO_compute; precision picks exp for the lability sigmoid.
+ * Time complexity: O(registered models)
+ */
+void fill_instant_metrics(AnalysisResult& result,
+                          const Instant_Shared& shared,
+                          const VADPoint& current,
+                          double stabilityRadius,
+                          const weight& w,
+                          const variable& v,
+                          math_precision precision)
+{
+    const Interval_Params params = make_interval_params(EGO_axis{VADPoint{0.0, 0.0, 0.0, 0.0}, stabilityRadius}, w, v);
+    const Instant_Terms terms = with_stress_model(params, [&](const auto& model)
+    {
+        return get_instant_terms(current, shared.deviation, stabilityRadius, v.dampening_factor, model);
+    });
+    fill_instant_metrics(result, shared, terms, w, v, precision);
+}
+
+/*
+ * Ratios, deviation and dynamics around stress / reward some model already computed.
+ * Time complexity: O(1)
+ */
+void fill_instant_metrics(AnalysisResult& result,
+                          const Instant_Shared& shared,
+                          const Instant_Terms& terms,
+                          const weight& w,
+                          const variable& v,
+                          math_precision precision)
+{
+    const Ratio ratio = get_stress_reward_ratio(terms.stress, terms.reward);
+
+    result.instant.stress = terms.stress;
+    result.instant.reward = terms.reward;
+    result.instant.ratio_total = ratio.ratio_total;
+    result.instant.stress_ratio = ratio.stress_ratio;
+    result.instant.reward_ratio = ratio.reward_ratio;
+    result.instant.deviation = shared.deviation;
+
+    result.dynamics.delta = shared.delta;
+    result.dynamics.affective_lability = with_math_precision(precision, [&](auto mode)
+    {
+        return math_sigmoid<decltype(mode)::value>(w.weight_k * (shared.theta - v.theta_0));
+    });
+}
+// O(1) ------------------------------------------------------------------------------
+
+
+
+// O(n) ------------------------------------------------------------------------------
+/*
+ * This funtion returns average emotion area based on history.
+ * History must be up-to-date for accuracy.
+ * Time complexity: O(n) = 2T(n)
+ * Space complexity: O(1)
+ */ 
+VAD_ave calculate_average(const HistorySpan& history)
+{
+    size_t history_size = history.size;
+    // if history is empty
+    if(history_size == 0)
+    {
+        return VAD_ave{0.0, 0.0, 0.0, 0.05};
+    }    
+    
+    // calculate average emotion's center
+    double v = 0, a = 0, d = 0;
+    for(size_t i = 0; i < history_size; i++)
+    {
+        v += history.v_at(i);
+        a += history.a_at(i);
+        d += history.d_at(i);
+    }    
+    v /= history_size; a /= history_size; d /= history_size;
+    
+    // calculate radius of average emotion
+    VADPoint average_center{v,a,d,0.0};
+    double r = 0;
+    for(size_t i = 0; i < history_size; i++)
+    {
+        r += get_distance(average_center, history.point(i));
+    }    
+    r /= history_size;
+    
+    return VAD_ave{v,a,d,r};
+}    
+
+/*
+ * Long histories are reduced in fixed blocks of REDUCE_BLOCK samples and the block partials
+ * are added pairwise in a fixed tree. The block layout never depends on the thread count,
+ * so results are bitwise identical for any `threads`.
+ */
+constexpr size_t REDUCE_BLOCK = size_t(1) << 16;
+
+inline double combine(double lhs, double rhs) { return lhs + rhs; }
+inline Block_Sums combine(const Block_Sums& lhs, const Block_Sums& rhs)
+{
+    return Block_Sums{ lhs.v + rhs.v, lhs.a + rhs.a, lhs.d + rhs.d, lhs.stress + rhs.stress, lhs.reward + rhs.reward };
+}
+
+/*
+ * Sums parts[lo, hi) as a balanced tree (same shape every time).
+ * Time complexity: O(hi - lo)
+ * Space complexity: O(log(hi - lo)) stack
+ */
+template <typename T>
+T pairwise_reduce(const std::vector<T>& parts, size_t lo, size_t hi)
+{
+    if (hi - lo == 1)
+        return parts[lo];
+
+    const size_t mid = lo + (hi - lo) / 2;
+    return combine(pairwise_reduce(parts, lo, mid), pairwise_reduce(parts, mid, hi));
+}
+
+/*
+ * Pass 2 over samples [begin, end): sum of distances to the center (v/a/d columns only).
+ * Time complexity: O(end - begin)
+ * Space complexity: O(1)
+ */
+template <typename Stride>
+double history_block_radius(const HistorySpan& history, size_t begin, size_t end, Stride stride,
+                            double v, double a, double d)
+{
+    const double* xs = history.v;
+    const double* ys = history.a;
+    const double* zs = history.d;
+
+    double lane_r[4] = {};
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        for (size_t l = 0; l < 4; l++)
+        {
+            const double dx = v - xs[(i + l) * stride];
+            const double dy = a - ys[(i + l) * stride];
+            const double dz = d - zs[(i + l) * stride];
+            lane_r[l] += std::sqrt(dx*dx + dy*dy + dz*dz);
+        }
+    }
+    for (; i < end; i++)
+    {
+        const double dx = v - xs[i * stride];
+        const double dy = a - ys[i * stride];
+        const double dz = d - zs[i * stride];
+        lane_r[0] += std::sqrt(dx*dx + dy*dy + dz*dz);
+    }
+    return lane_sum(lane_r);
+}
+
+struct Lability_Params
+{
+    double weight_k;
+    double theta_0;
+    double threshold;
+    math_precision precision;
+};
+
+struct Lability_Sums
+{
+    double sum;
+    double max;
+    size_t above;
+};
+
+inline Lability_Sums combine(const Lability_Sums& lhs, const Lability_Sums& rhs)
+{
+    return Lability_Sums{ lhs.sum + rhs.sum, std::max(lhs.max, rhs.max), lhs.above + rhs.above };
+}
+
+// state of the optional lability aggregation riding along pass 1
+struct Lability_Pass
+{
+    Lability_Params params;
+    std::vector<double> series;     // per-sample lability, row 0 = 0 (no transition)
+    Lability_Sums total{0.0, 0.0, 0};
+};
+
+/*
+ * Lability of transition (j-1 -> j). Same math as calculate_delta + calculate_affective_lability.
+ * Time complexity: O(1)
+ */
+template <math_precision Precision, typename Stride>
+inline double transition_lability(const HistorySpan& history, size_t j, Stride stride, const Lability_Params& p)
+{
+    const double dt_raw = history.timestamp[j * stride] - history.timestamp[(j - 1) * stride];
+    const double dt = (dt_raw <= 0) ? 1.0 : dt_raw;
+    const double dv = (history.v[j * stride] - history.v[(j - 1) * stride]) / dt;
+    const double da = (history.a[j * stride] - history.a[(j - 1) * stride]) / dt;
+    const double dd = (history.d[j * stride] - history.d[(j - 1) * stride]) / dt;
+
+    const double theta = math_atan2<Precision>(dd, std::sqrt(dv*dv + da*da));
+    return math_sigmoid<Precision>(p.weight_k * (theta - p.theta_0));
+}
+
+// transitions per tile: the map loop writes them, the reduction reads them back from L1
+constexpr size_t LABILITY_TILE = 1024;
+
+/*
+ * Lability of the transitions ending in [begin, end): writes series[i] and returns sum / max / count above threshold.
+ * Each tile is a plain map loop (series[j] = lability) followed by a 4-lane reduction, both branch-free;
+ * with Precision == fast atan2 / exp are inline too, so the map loop vectorizes.
+ * Time complexity: O(end - begin)
+ * Space complexity: O(1)
+ */
+template <math_precision Precision, typename Stride>
+Lability_Sums history_block_lability_impl(const HistorySpan& history, size_t begin, size_t end, Stride stride,
+                                          const Lability_Params& p, double* series)
+{
+    size_t i = begin;
+    if (begin == 0)
+    {
+        series[0] = 0.0;
+        i = 1;
+    }
+
+    double lane_sum_l[4] = {}, lane_max[4] = {};
+    size_t lane_above[4] = {};
+    for (; i < end; i += LABILITY_TILE)
+    {
+        const size_t tile_end = std::min(end, i + LABILITY_TILE);
+
+        for (size_t j = i; j < tile_end; j++)
+            series[j] = transition_lability<Precision>(history, j, stride, p);
+
+        size_t j = i;
+        for (; j + 4 <= tile_end; j += 4)
+        {
+            for (size_t l = 0; l < 4; l++)
+            {
+                const double lability = series[j + l];
+                lane_sum_l[l] += lability;
+                lane_max[l] = (lability > lane_max[l]) ? lability : lane_max[l];
+                lane_above[l] += (lability > p.threshold);
+            }
+        }
+        for (; j < tile_end; j++)
+        {
+            const double lability = series[j];
+            lane_sum_l[0] += lability;
+            lane_max[0] = (lability > lane_max[0]) ? lability : lane_max[0];
+            lane_above[0] += (lability > p.threshold);
+        }
+    }
+
+    return Lability_Sums{ lane_sum(lane_sum_l),
+                          std::max(std::max(lane_max[0], lane_max[1]), std::max(lane_max[2], lane_max[3])),
+                          (lane_above[0] + lane_above[1]) + (lane_above[2] + lane_above[3]) };
+}
+
+// picks the exact / fast instantiation once per block
+template <typename Stride>
+Lability_Sums history_block_lability(const HistorySpan& history, size_t begin, size_t end, Stride stride,
+                                     const Lability_Params& p, double* series)
+{
+    return with_math_precision(p.precision, [&](auto precision)
+    {
+        return history_block_lability_impl<decltype(precision)::value>(history, begin, end, stride, p, series);
+    });
+}
+
+/*
+ * Mean / max / count of a finished lability pass, plus the rolling mean over window_seconds
+ * (two pointers over the series, so O(n) for any window).
+ * Time complexity: O(n)
+ * Space complexity: O(n) (the rolling series)
+ */
+LabilityMetrics finish_lability(const HistorySpan& history, Lability_Pass& pass, double window_seconds)
+{
+    LabilityMetrics out;
+    out.count = (history.size > 1) ? history.size - 1 : 0;
+    out.mean = (out.count > 0) ? pass.total.sum / out.count : 0.0;
+    out.max = pass.total.max;
+    out.above_threshold = pass.total.above;
+
+    if (window_seconds > 0 && history.size > 0)
+    {
+        const std::vector<double>& series = pass.series;
+        out.rolling.assign(history.size, 0.0);
+
+        size_t oldest = 1;
+        double sum = 0.0;
+        for (size_t i = 1; i < history.size; i++)
+        {
+            sum += series[i];
+            const double from = history.timestamp_at(i) - window_seconds;
+            while (history.timestamp_at(oldest) < from)
+                sum -= series[oldest++];
+
+            out.rolling[i] = sum / (i - oldest + 1);
+        }
+    }
+    return out;
+}
+
+/*
+ * Lability pass on its own (cumulative modes other than lifetime), same block layout as pass 1.
+ * Time complexity: O(n / threads)
+ * Space complexity: O(n)
+ */
+template <typename Stride>
+void run_lability_pass(const HistorySpan& history, Stride stride, Lability_Pass& pass, unsigned int threads)
+{
+    const size_t history_size = history.size;
+    const size_t blocks = (history_size + REDUCE_BLOCK - 1) / REDUCE_BLOCK;
+
+    std::vector<Lability_Sums> parts(blocks);
+    parallel_for(blocks, threads, [&](size_t b)
+    {
+        parts[b] = history_block_lability(history, b * REDUCE_BLOCK, std::min(history_size, (b + 1) * REDUCE_BLOCK),
+                                          stride, pass.params, pass.series.data());
+    }, 1);
+    pass.total = pairwise_reduce(parts, 0, blocks);
+}
+
+/*
+ * Body of get_history_functions_fused for one stride type.
+ * Up to REDUCE_BLOCK samples run straight on the calling thread; longer histories
+ * spread their blocks over `threads` workers for each pass.
+ * Time complexity: O(n / threads) = T(n) + T(n)
+ * Space complexity: O(n / REDUCE_BLOCK)
+ */
+template <typename Stride, typename Block_Fn>
+History_Tasks_Result history_functions_fused_impl(const HistorySpan& history, Stride stride, Block_Fn&& block_sums,
+                                                  Lability_Pass* lability, unsigned int threads)
+{
+    const size_t history_size = history.size;
+    const size_t blocks = (history_size + REDUCE_BLOCK - 1) / REDUCE_BLOCK;
+    auto block_end = [&](size_t b) { return std::min(history_size, (b + 1) * REDUCE_BLOCK); };
+
+    // pass 1
+    Block_Sums total;
+    if (blocks == 1)
+    {
+        total = block_sums(size_t(0), history_size);
+        if (lability)
+            lability->total = history_block_lability(history, 0, history_size, stride, lability->params, lability->series.data());
+    }
+    else
+    {
+        std::vector<Block_Sums> parts(blocks);
+        std::vector<Lability_Sums> lability_parts(lability ? blocks : 0);
+        parallel_for(blocks, threads, [&](size_t b)
+        {
+            parts[b] = block_sums(b * REDUCE_BLOCK, block_end(b));
+
+            // same block, same worker: the columns are still in cache
+            if (lability)
+                lability_parts[b] = history_block_lability(history, b * REDUCE_BLOCK, block_end(b), stride,
+                                                           lability->params, lability->series.data());
+        }, 1);
+        total = pairwise_reduce(parts, 0, blocks);
+        if (lability)
+            lability->total = pairwise_reduce(lability_parts, 0, blocks);
+    }
+
+    const double v = total.v / history_size;
+    const double a = total.a / history_size;
+    const double d = total.d / history_size;
+
+    // pass 2
+    double radius_sum;
+    if (blocks == 1)
+    {
+        radius_sum = history_block_radius(history, 0, history_size, stride, v, a, d);
+    }
+    else
+    {
+        std::vector<double> parts(blocks);
+        parallel_for(blocks, threads, [&](size_t b)
+        {
+            parts[b] = history_block_radius(history, b * REDUCE_BLOCK, block_end(b), stride, v, a, d);
+        }, 1);
+        radius_sum = pairwise_reduce(parts, 0, blocks);
+    }
+    const double r = radius_sum / history_size;
+
+    return History_Tasks_Result{ VAD_ave{v, a, d, r}, get_stress_reward_ratio(total.stress, total.reward), std::nullopt };
+}
+
+/*
+ * Fused history kernel. Returns the center + mean radius (calculate_average) and the
+ * stress / reward integrals: sum over intervals (i-1 -> i) of instant stress / reward at i times dt
+ * (non-positive dt -> 0.1). Compared with walking the history once per metric:
+ *  1) center sums, stress integral and reward integral share one pass over the columns,
+ *  2) the mean radius is a second pass over the v/a/d columns only,
+ *  3) histories longer than REDUCE_BLOCK are split into blocks reduced on `threads` workers,
+ *  4) the stress/reward model is picked once (with_stress_model), so preset weights are constants in the loop;
+ *     a caller's model (`custom`, EGO_model.hpp) runs its own pass 1 through one pointer call per block,
+ *  5) if `lability` is set, pass 1 also aggregates lability of every transition, block by block.
+ * Loop bodies are branch-free and keep 4 independent partial sums (lanes),
+ * so the compiler can vectorize them.
+ * Time complexity: O(n / threads) = T(n) + T(n)
+ * Space complexity: O(n / REDUCE_BLOCK)
+ */
+History_Tasks_Result get_history_functions_fused(const HistorySpan& history, const Interval_Params& params,
+                                                 Lability_Pass* lability, unsigned int threads,
+                                                 const model_kernels* custom)
+{
+    // if history is empty
+    if (history.size == 0)
+        return History_Tasks_Result{ VAD_ave{0.0, 0.0, 0.0, 0.05}, get_stress_reward_ratio(0.0, 0.0), std::nullopt };
+
+    if (custom)
+    {
+        auto block_sums = [&](size_t begin, size_t end) { return custom->block_sums(history, begin, end, params); };
+        if (history.stride == 1)
+            return history_functions_fused_impl(history, std::integral_constant<size_t, 1>{}, block_sums, lability, threads);
+        return history_functions_fused_impl(history, history.stride, block_sums, lability, threads);
+    }
+
+    return with_stress_model(params, [&](const auto& model)
+    {
+        if (history.stride == 1)
+        {
+            const std::integral_constant<size_t, 1> stride{};
+            return history_functions_fused_impl(history, stride, [&](size_t begin, size_t end)
+            {
+                return history_block_sums(history, begin, end, stride, params, model);
+            }, lability, threads);
+        }
+
+        return history_functions_fused_impl(history, history.stride, [&](size_t begin, size_t end)
+        {
+            return history_block_sums(history, begin, end, history.stride, params, model);
+        }, lability, threads);
+    });
+}
+
+/*
+ * This function picks the cumulative kernel requested by user_in.cumulative:
+ * lifetime (fused kernel), sliding time window, exponential decay, or lifetime on a uniform grid.
+ * With user_in.lability set it also fills History_Tasks_Result.lability (inside pass 1 for lifetime).
+ * Only the lifetime kernel and the lability pass use `threads`, and only the lifetime kernel takes a `custom` model.
+ * Time complexity: O(n / threads) lifetime, O(n) decay, O(window) window, O(n + grid) resampled
+ * Space complexity: O(1), O(n) with lability (per-sample series)
+ */
+History_Tasks_Result get_history_functions(const compute_in& user_in, const Interval_Params& params, unsigned int threads,
+                                           const model_kernels* custom)
+{
+    const HistorySpan history = user_in.history_span();
+    const cumulative_option option = user_in.cumulative.value_or(cumulative_option{});
+
+    // optional lability aggregates
+    std::optional<Lability_Pass> lability;
+    if (user_in.lability)
+    {
+        const weight w = user_in.weights.value_or(weight{});
+        const variable v = user_in.variables.value_or(variable{});
+        lability = Lability_Pass{ Lability_Params{w.weight_k, v.theta_0, user_in.lability->threshold, user_in.lability->precision},
+                                  std::vector<double>(history.size) };
+    }
+
+    History_Tasks_Result result;
+    if (option.mode == cumulative_mode::lifetime)
+    {
+        result = get_history_functions_fused(history, params, lability ? &*lability : nullptr, threads, custom);
+    }
+    else
+    {
+        CumulativeMetrics metrics;
+        if (option.mode == cumulative_mode::window)
+            metrics = calculate_window_cumulative(history, params, option.window_seconds);
+        else if (option.mode == cumulative_mode::decay)
+            metrics = calculate_decay_cumulative(history, params, option.half_life);
+        else
+            metrics = calculate_resampled_cumulative(history, params, resample_option{option.resample_step, option.resample});
+
+        result = History_Tasks_Result{ metrics.average_area, get_stress_reward_ratio(metrics.stress, metrics.reward), std::nullopt };
+
+        if (lability && history.size > 0)
+        {
+            if (history.stride == 1)
+                run_lability_pass(history, std::integral_constant<size_t, 1>{}, *lability, threads);
+            else
+                run_lability_pass(history, history.stride, *lability, threads);
+        }
+    }
+
+    if (lability)
+        result.lability = finish_lability(history, *lability, user_in.lability->window_seconds);
+    return result;
+}
+// O(n) ------------------------------------------------------------------------------
+
+
+/**
+ * This function packs the history task results into AnalysisResult.cumulative / lability.
+ * Time complexity = O(1)
+ * Space complexity = O(1)
+ */
+void pack_history_results(AnalysisResult& result, History_Tasks_Result&& history_results)
+{
+    result.cumulative.average_area = history_results.average;
+    result.cumulative.stress = history_results.cumulative.stress_raw;
+    result.cumulative.reward = history_results.cumulative.reward_raw;
+    result.cumulative.total = history_results.cumulative.ratio_total;
+    result.cumulative.stress_ratio = history_results.cumulative.stress_ratio;
+    result.cumulative.reward_ratio = history_results.cumulative.reward_ratio;
+    result.lability = std::move(history_results.lability);
+}
+
+// analize 
+AnalysisResult EGO_compute(const compute_in& user_in)
+{
+    EGO_axis base = user_in.emotion_base.value_or(EGO_axis{});
+    weight w = user_in.weights.value_or(weight{});
+    variable v = user_in.variables.value_or(variable{});
+
+    // thread executes O(n) = T(n) + T(n) history kernel
+    auto thread_history = std::async(std::launch::async,
+        get_history_functions,
+        std::cref(user_in),
+        make_interval_params(base, w, v),
+        user_in.threads,
+        static_cast<const model_kernels*>(nullptr)
+    );
+
+    // O(1) part runs on this thread meanwhile (the same two calls the sweep uses)
+    AnalysisResult result;
+    fill_instant_metrics(result, calculate_instant_shared(user_in.current, user_in.prev, base.baseline),
+                         user_in.current, base.stabilityRadius, w, v);
+
+    // get result from thread
+    pack_history_results(result, thread_history.get());
+    return result;
+}
+
+/*
+ * EGO_compute with a caller's stress model (EGO_compute<Model>, EGO_model.hpp):
+ * its instant terms for the O(1) part, its pass-1 block kernel for the lifetime integrals.
+ * Time complexity: O(n / threads)
+ * Space complexity: O(n / REDUCE_BLOCK)
+ */
+AnalysisResult EGO_compute(const compute_in& user_in, const model_kernels& kernels)
+{
+    if (user_in.cumulative && user_in.cumulative->mode != cumulative_mode::lifetime)
+        throw std::invalid_argument("a custom stress model supports cumulative_mode::lifetime only");
+
+    EGO_axis base = user_in.emotion_base.value_or(EGO_axis{});
+    weight w = user_in.weights.value_or(weight{});
+    variable v = user_in.variables.value_or(variable{});
+    const Interval_Params params = make_interval_params(base, w, v);
+
+    auto thread_history = std::async(std::launch::async,
+        get_history_functions,
+        std::cref(user_in),
+        params,
+        user_in.threads,
+        &kernels
+    );
+
+    AnalysisResult result;
+    const Instant_Shared shared = calculate_instant_shared(user_in.current, user_in.prev, base.baseline);
+    fill_instant_metrics(result, shared, kernels.instant(user_in.current, shared.deviation, base.stabilityRadius, params), w, v);
+
+    pack_history_results(result, thread_history.get());
+    return result;
+}
+
+/*
+ * Same analysis as EGO_compute, but every task runs on the calling thread.
+ * Used by batch workers, which are already parallel across sessions.
+ * precision applies to the O(1) lability (the history pass follows user_in.lability).
+ * Time complexity: O(n)
+ * Space complexity: O(1)
+ */
+AnalysisResult EGO_compute_sync(const compute_in& user_in, math_precision precision)
+{
+    EGO_axis base = user_in.emotion_base.value_or(EGO_axis{});
+    weight w = user_in.weights.value_or(weight{});
+    variable v = user_in.variables.value_or(variable{});
+
+    AnalysisResult result;
+    fill_instant_metrics(result, calculate_instant_shared(user_in.current, user_in.prev, base.baseline, precision),
+                         user_in.current, base.stabilityRadius, w, v, precision);
+    pack_history_results(result, get_history_functions(user_in, make_interval_params(base, w, v), 1, nullptr));
+    return result;
+}
+
+/*
+ * Builds a compute_in that reads `history` in place (history_view), nothing is copied.
+ */
+compute_in make_compute_in(const VADPoint& current,
+                           const HistorySpan& history,
+                           const std::optional<VADPoint>& prev,
+                           const std::optional<EGO_axis>& emotion_base,
+                           const std::optional<variable>& variables,
+                           const std::optional<weight>& weights)
+{
+    compute_in user_in;
+    user_in.current = current;
+    user_in.history_view = history;
+    user_in.prev = prev;
+    user_in.emotion_base = emotion_base;
+    user_in.variables = variables;
+    user_in.weights = weights;
+    return user_in;
+}
+
+AnalysisResult EGO_compute(const VADPoint& current,
+                           const HistorySpan& history,
+                           const std::optional<VADPoint>& prev,
+                           const std::optional<EGO_axis>& emotion_base,
+                           const std::optional<variable>& variables,
+                           const std::optional<weight>& weights,
+                           unsigned int threads)
+{
+    compute_in user_in = make_compute_in(current, history, prev, emotion_base, variables, weights);
+    user_in.threads = threads;
+    return EGO_compute(user_in);
+}
+
+AnalysisResult EGO_compute_sync(const VADPoint& current,
+                                const HistorySpan& history,
+                                const std::optional<VADPoint>& prev,
+                                const std::optional<EGO_axis>& emotion_base,
+                                const std::optional<variable>& variables,
+                                const std::optional<weight>& weights,
+                                math_precision precision)
+{
+    return EGO_compute_sync(make_compute_in(current, history, prev, emotion_base, variables, weights), precision);
 }
\ No newline at end of file
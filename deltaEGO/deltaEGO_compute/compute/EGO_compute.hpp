@@ -1,80 +1,196 @@
-#pragma once
-#include <pybind11/pybind11.h>
-#include <pybind11/stl.h>
-#include <optional>
-#include <vector>
-#include <future>
-#include <variant>
-#include <cmath>
-#include <algorithm>
-#include "VAD.hpp"
-// return struct------------------------------------------------------------
-struct InstantMetrics 
-{
-    double stress;
-    double reward;
-    double ratio_total;
-    double stress_ratio;
-    double reward_ratio;
-    double deviation;
-};
-
-struct DynamicMetrics 
-{
-    VADPoint delta;
-    double affective_lability;
-};
-
-struct CumulativeMetrics 
-{
-    VAD_ave average_area;
-    double stress;
-    double reward;
-    double total;
-    double stress_ratio;
-    double reward_ratio;
-};
-
-struct AnalysisResult
-{
-    InstantMetrics instant;
-    DynamicMetrics dynamics;
-    CumulativeMetrics cumulative;
-};
-// return struct------------------------------------------------------------
-
-// input struct-------------------------------------------------------------
-struct weight
-{
-    double weightA_stress = 0.7;
-    double weightV_stress = 0.3;
-    double weightV_reward = 0.5;
-    double weightA_reward = 0.5;
-    double weight_k = 0.5;
-    
-};
-struct variable
-{
-    double theta_0 = 0;
-    double dampening_factor = 0.08;
-};
-struct EGO_axis
-{
-    VADPoint baseline{0.0, 0.0, 0.0, 0.0};
-    double stabilityRadius = 0.3;
-};
-struct compute_in
-{
-    VADPoint current;
-    std::vector<VADPoint> history;
-
-    std::optional<VADPoint> prev;
-
-    std::optional<EGO_axis> emotion_base;
-    std::optional<variable> variables;
-    std::optional<weight> weights; 
-};
-// input struct-------------------------------------------------------------
-
-// main --------------------------------------------------------------------
-AnalysisResult EGO_compute(const compute_in& user_in);
\ No newline at end of file
+#pragma once
+#include <optional>
+#include <vector>
+#include <future>
+#include <variant>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+#include "VAD.hpp"
+#include "VAD_history.hpp"
+// return struct------------------------------------------------------------
+struct InstantMetrics 
+{
+    double stress;
+    double reward;
+    double ratio_total;
+    double stress_ratio;
+    double reward_ratio;
+    double deviation;
+};
+
+struct DynamicMetrics 
+{
+    VADPoint delta;
+    double affective_lability;
+};
+
+struct CumulativeMetrics 
+{
+    VAD_ave average_area;
+    double stress;
+    double reward;
+    double total;
+    double stress_ratio;
+    double reward_ratio;
+};
+
+// lability over every transition of the history (compute_in.lability)
+struct LabilityMetrics
+{
+    double mean = 0;
+    double max = 0;
+    std::size_t above_threshold = 0;    // transitions with lability > threshold
+    std::size_t count = 0;              // transitions (history size - 1)
+    std::vector<double> rolling;        // row i: mean over transitions in [t_i - window_seconds, t_i] (row 0 = 0)
+};
+
+struct AnalysisResult
+{
+    InstantMetrics instant;
+    DynamicMetrics dynamics;
+    CumulativeMetrics cumulative;
+    std::optional<LabilityMetrics> lability;   // only when compute_in.lability is set
+};
+// return struct------------------------------------------------------------
+
+// input struct-------------------------------------------------------------
+struct weight
+{
+    double weightA_stress = 0.7;
+    double weightV_stress = 0.3;
+    double weightV_reward = 0.5;
+    double weightA_reward = 0.5;
+    double weight_k = 0.5;
+    
+};
+struct variable
+{
+    double theta_0 = 0;
+    double dampening_factor = 0.08;
+};
+struct EGO_axis
+{
+    VADPoint baseline{0.0, 0.0, 0.0, 0.0};
+    double stabilityRadius = 0.3;
+};
+// which part of history the cumulative metrics integrate over
+enum class cumulative_mode
+{
+    lifetime,   // whole history (default)
+    window,     // only the last window_seconds
+    decay,      // every interval, weighted by 2^(-age / half_life)
+    resampled   // whole history on a uniform grid of resample_step (EGO_resample.hpp)
+};
+enum class resample_mode
+{
+    linear,     // interpolate between the samples around each grid time
+    hold        // last sample at or before each grid time
+};
+struct cumulative_option
+{
+    cumulative_mode mode = cumulative_mode::lifetime;
+    double window_seconds = 3600.0;
+    double half_life = 600.0;
+    double resample_step = 1.0;
+    resample_mode resample = resample_mode::linear;
+};
+enum class math_precision
+{
+    exact,      // libm exp / atan2
+    fast        // branch-free polynomial versions, a few ulp (EGO_fastmath.hpp), vectorizable
+};
+struct lability_option
+{
+    double threshold = 0.7;
+    double window_seconds = 0.0;    // > 0 also fills LabilityMetrics.rolling
+    math_precision precision = math_precision::exact;
+};
+struct compute_in
+{
+    VADPoint current;
+    VADHistory history;
+
+    std::optional<VADPoint> prev;
+
+    std::optional<EGO_axis> emotion_base;
+    std::optional<variable> variables;
+    std::optional<weight> weights; 
+
+    std::optional<cumulative_option> cumulative;
+
+    // workers for the lifetime O(n) kernel on histories longer than one reduction block
+    // (0 = every hardware thread); results are bitwise identical for any value
+    unsigned int threads = 1;
+
+    // reference baselines for EGO_compute_baselines (EGO_baselines.hpp); EGO_compute ignores them
+    std::vector<EGO_axis> baselines;
+
+    // if set, the history pass also aggregates lability over every transition
+    std::optional<lability_option> lability;
+
+    // if set, history is read from here instead (numpy buffer, mapped file ...), not owned
+    std::optional<HistorySpan> history_view;
+
+    HistorySpan history_span() const { return history_view ? *history_view : history.span(); }
+};
+// input struct-------------------------------------------------------------
+
+// main --------------------------------------------------------------------
+AnalysisResult EGO_compute(const compute_in& user_in);
+// same as above, history is any column view (VADHistory, numpy, mapped file...)
+AnalysisResult EGO_compute(const VADPoint& current,
+                           const HistorySpan& history,
+                           const std::optional<VADPoint>& prev,
+                           const std::optional<EGO_axis>& emotion_base,
+                           const std::optional<variable>& variables,
+                           const std::optional<weight>& weights,
+                           unsigned int threads = 1);
+
+// same as EGO_compute without spawning threads (for callers that are already parallel);
+// precision picks atan2 / exp of the O(1) lability (EGO_fastmath.hpp)
+AnalysisResult EGO_compute_sync(const compute_in& user_in, math_precision precision = math_precision::exact);
+AnalysisResult EGO_compute_sync(const VADPoint& current,
+                                const HistorySpan& history,
+                                const std::optional<VADPoint>& prev,
+                                const std::optional<EGO_axis>& emotion_base,
+                                const std::optional<variable>& variables,
+                                const std::optional<weight>& weights,
+                                math_precision precision = math_precision::exact);
+
+// building blocks ---------------------------------------------------------
+// center + mean radius of a history (does not depend on weights / variables)
+VAD_ave calculate_average(const HistorySpan& history);
+
+// O(1) terms that don't depend on weights / variables
+struct Instant_Shared
+{
+    VADPoint delta;     // (current - prev) / dt, 0 without prev
+    double theta;       // slope of delta, input of the lability sigmoid
+    double deviation;   // distance of current to the baseline
+};
+Instant_Shared calculate_instant_shared(const VADPoint& current,
+                                        const std::optional<VADPoint>& prev,
+                                        const VADPoint& baseline,
+                                        math_precision precision = math_precision::exact);
+// instant stress (dampened) and reward of one stress model (get_instant_terms, EGO_kernel.hpp)
+struct Instant_Terms
+{
+    double stress;
+    double reward;
+};
+// InstantMetrics + DynamicMetrics of one weights / variables set (same values as EGO_compute)
+void fill_instant_metrics(AnalysisResult& result,
+                          const Instant_Shared& shared,
+                          const VADPoint& current,
+                          double stabilityRadius,
+                          const weight& w,
+                          const variable& v,
+                          math_precision precision = math_precision::exact);
+// same with stress / reward already computed by a model; w / v only give the lability sigmoid
+void fill_instant_metrics(AnalysisResult& result,
+                          const Instant_Shared& shared,
+                          const Instant_Terms& terms,
+                          const weight& w,
+                          const variable& v,
+                          math_precision precision = math_precision::exact);
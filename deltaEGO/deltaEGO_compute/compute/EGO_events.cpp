@@ -0,0 +1,194 @@
+#include "EGO_events.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+    std::size_t round_up_pow2(std::size_t n)
+    {
+        std::size_t p = 1;
+        while (p < n)
+            p <<= 1;
+        return p;
+    }
+
+    double metric_value(event_metric metric, const AnalysisResult& result, double stability_radius)
+    {
+        switch (metric)
+        {
+            case event_metric::instant_stress: return result.instant.stress;
+            case event_metric::instant_reward: return result.instant.reward;
+            case event_metric::affective_lability: return result.dynamics.affective_lability;
+            case event_metric::deviation: return result.instant.deviation;
+            case event_metric::outside_radius: return result.instant.deviation - stability_radius;
+        }
+        return 0.0;
+    }
+
+    constexpr std::uint32_t EVENT_START = 0;
+    constexpr std::uint32_t EVENT_END = 1;
+}
+
+// EventQueue ----------------------------------------------------------------------
+EventQueue::EventQueue(std::size_t capacity)
+{
+    const std::size_t n = round_up_pow2(std::max<std::size_t>(capacity, 2));
+    this->cells = std::make_unique<Cell[]>(n);
+    this->mask = n - 1;
+    for (std::size_t i = 0; i < n; i++)
+        this->cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+/*
+ * Cell is free for position pos when its sequence == pos.
+ * Time complexity: O(1) (retries only under contention)
+ */
+bool EventQueue::push(const DetectorEvent& event)
+{
+    std::size_t pos = this->enqueue_pos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        Cell& cell = this->cells[pos & this->mask];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+        if (diff == 0)
+        {
+            if (this->enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                cell.event = event;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;   // full
+        }
+        else
+        {
+            pos = this->enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/*
+ * Cell holds the event for position pos when its sequence == pos + 1.
+ * Time complexity: O(1)
+ */
+bool EventQueue::pop(DetectorEvent& event)
+{
+    std::size_t pos = this->dequeue_pos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        Cell& cell = this->cells[pos & this->mask];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+
+        if (diff == 0)
+        {
+            if (this->dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                event = cell.event;
+                cell.sequence.store(pos + this->mask + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;   // empty
+        }
+        else
+        {
+            pos = this->dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// EventDetector -------------------------------------------------------------------
+EventDetector::EventDetector(const std::vector<event_rule>& rules, std::size_t queue_capacity)
+    : rule_list(rules), queue(queue_capacity)
+{
+    if (rules.empty())
+        throw std::invalid_argument("EventDetector needs at least one rule");
+    for (const event_rule& rule : rules)
+    {
+        if (rule.hold_seconds < 0)
+            throw std::invalid_argument("event_rule.hold_seconds must not be negative");
+    }
+}
+
+// Fibonacci hash, top 4 bits pick one of the 16 shards
+EventDetector::Shard& EventDetector::shard_of(std::uint64_t stream)
+{
+    return this->shards[(stream * 0x9e3779b97f4a7c15ULL) >> 60];
+}
+
+void EventDetector::emit(const DetectorEvent& event)
+{
+    // a full queue never blocks the update path; the loss is counted instead
+    if (!this->queue.push(event))
+        this->dropped_events.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*
+ * Time complexity: O(rules)
+ */
+void EventDetector::observe(std::uint64_t stream, double timestamp, const AnalysisResult& result,
+                            double stability_radius)
+{
+    Shard& shard = this->shard_of(stream);
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    std::vector<Rule_State>& states = shard.streams[stream];
+    if (states.empty())
+        states.assign(this->rule_list.size(), Rule_State{std::numeric_limits<double>::quiet_NaN(), false});
+
+    for (std::size_t r = 0; r < this->rule_list.size(); r++)
+    {
+        const event_rule& rule = this->rule_list[r];
+        Rule_State& state = states[r];
+        const double value = metric_value(rule.metric, result, stability_radius);
+
+        if (value > rule.threshold)
+        {
+            if (std::isnan(state.above_since))
+                state.above_since = timestamp;
+
+            if (!state.active && timestamp - state.above_since >= rule.hold_seconds)
+            {
+                state.active = true;
+                this->emit(DetectorEvent{stream, timestamp, value, static_cast<std::uint32_t>(r), EVENT_START});
+            }
+        }
+        else
+        {
+            if (state.active && rule.report_end)
+                this->emit(DetectorEvent{stream, timestamp, value, static_cast<std::uint32_t>(r), EVENT_END});
+
+            state.above_since = std::numeric_limits<double>::quiet_NaN();
+            state.active = false;
+        }
+    }
+}
+
+/*
+ * Time complexity: O(events returned)
+ */
+std::vector<DetectorEvent> EventDetector::drain(std::size_t max_events)
+{
+    std::vector<DetectorEvent> events;
+    DetectorEvent event;
+    while ((max_events == 0 || events.size() < max_events) && this->queue.pop(event))
+        events.push_back(event);
+    return events;
+}
+
+void EventDetector::forget(std::uint64_t stream)
+{
+    Shard& shard = this->shard_of(stream);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    shard.streams.erase(stream);
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "EGO_compute.hpp"
+
+// return struct------------------------------------------------------------
+/*
+ * One detector event: 32 bytes, all plain fields (drained into a numpy record array).
+ * kind: 0 = rule became active, 1 = rule ended.
+ */
+struct DetectorEvent
+{
+    std::uint64_t stream;
+    double timestamp;
+    double value;           // metric value at that update
+    std::uint32_t rule;     // index into the detector's rules
+    std::uint32_t kind;
+};
+static_assert(sizeof(DetectorEvent) == 32, "DetectorEvent must stay 32 bytes");
+// return struct------------------------------------------------------------
+
+// input struct-------------------------------------------------------------
+enum class event_metric
+{
+    instant_stress,
+    instant_reward,
+    affective_lability,
+    deviation,          // distance from baseline, against a fixed threshold
+    outside_radius      // deviation - the stream's stabilityRadius: threshold 0 detects leaving it
+};
+/*
+ * Active while metric > threshold. The start event fires once the metric has stayed
+ * above for hold_seconds (0 = on the crossing update), the end event when it drops back.
+ */
+struct event_rule
+{
+    event_metric metric = event_metric::instant_stress;
+    double threshold = 0.7;
+    double hold_seconds = 0.0;
+    bool report_end = true;
+};
+// input struct-------------------------------------------------------------
+
+/*
+ * Bounded multi-producer / multi-consumer queue (Vyukov): each cell carries a sequence
+ * number, producers and consumers claim cells with one CAS and never block each other.
+ * push returns false when full. Capacity is rounded up to a power of two.
+ */
+class EventQueue
+{
+    public:
+    explicit EventQueue(std::size_t capacity);
+
+    bool push(const DetectorEvent& event);
+    bool pop(DetectorEvent& event);
+    std::size_t capacity() const { return this->mask + 1; }
+
+    private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        DetectorEvent event;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask;
+    alignas(64) std::atomic<std::size_t> enqueue_pos{0};
+    alignas(64) std::atomic<std::size_t> dequeue_pos{0};
+};
+
+/*
+ * Evaluates rules on every AnalysisResult of every stream and queues the transitions.
+ * observe() is called from the update path (SessionManager / EGOTracker, or directly)
+ * on any thread; per-stream state lives in sharded tables, events in the lock-free queue.
+ * drain() pulls them out in batches (from Python, without holding up the producers).
+ * Time complexity: observe O(rules), drain O(events)
+ */
+class EventDetector
+{
+    public:
+    explicit EventDetector(const std::vector<event_rule>& rules, std::size_t queue_capacity = 65536);
+
+    // stability_radius: the stream's EGO_axis.stabilityRadius (only outside_radius rules read it)
+    void observe(std::uint64_t stream, double timestamp, const AnalysisResult& result,
+                 double stability_radius = EGO_axis{}.stabilityRadius);
+    std::vector<DetectorEvent> drain(std::size_t max_events = 0);   // 0 = everything queued
+
+    void forget(std::uint64_t stream);  // drops a stream's rule state
+    const std::vector<event_rule>& rules() const { return this->rule_list; }
+    std::size_t dropped() const { return this->dropped_events.load(std::memory_order_relaxed); }
+
+    private:
+    struct Rule_State
+    {
+        double above_since;     // NaN while the metric is at or below threshold
+        bool active;
+    };
+
+    static constexpr std::size_t SHARDS = 16;
+    struct alignas(64) Shard
+    {
+        std::mutex lock;
+        std::unordered_map<std::uint64_t, std::vector<Rule_State>> streams;
+    };
+
+    Shard& shard_of(std::uint64_t stream);
+    void emit(const DetectorEvent& event);
+
+    std::vector<event_rule> rule_list;
+    Shard shards[SHARDS];
+    EventQueue queue;
+    std::atomic<std::size_t> dropped_events{0};
+};
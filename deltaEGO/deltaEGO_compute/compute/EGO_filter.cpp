@@ -0,0 +1,125 @@
+#include "EGO_filter.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    constexpr double TWO_PI = 6.283185307179586;
+
+    inline double smoothing_alpha(double dt, double cutoff)
+    {
+        return 1.0 / (1.0 + 1.0 / (TWO_PI * cutoff * dt));
+    }
+
+    /*
+     * One axis of one stream. `started` is 0 or 1: with 0 the raw value passes and speed resets.
+     * Time complexity: O(1)
+     */
+    inline void filter_axis(double& value, double& x, double& dx, double dt, double started, const filter_option& option)
+    {
+        const double raw = value;
+        const double speed = started * (raw - x) / dt;
+        dx += smoothing_alpha(dt, option.d_cutoff) * (speed - dx);
+        dx *= started;
+
+        const double cutoff = option.min_cutoff + option.beta * std::fabs(dx);
+        const double smoothed = x + smoothing_alpha(dt, cutoff) * (raw - x);
+        x = started * smoothed + (1.0 - started) * raw;
+        value = x;
+    }
+
+    void check_option(const filter_option& option)
+    {
+        if (!(option.min_cutoff > 0) || !(option.d_cutoff > 0) || option.beta < 0)
+            throw std::invalid_argument("filter_option needs min_cutoff > 0, d_cutoff > 0 and beta >= 0");
+    }
+}
+
+// OneEuroFilter -------------------------------------------------------------------
+OneEuroFilter::OneEuroFilter(const filter_option& option)
+    : settings(option)
+{
+    check_option(option);
+}
+
+VADPoint OneEuroFilter::filter(double V, double A, double D, double timestamp)
+{
+    const double dt_raw = timestamp - this->last_timestamp;
+    const double dt = (dt_raw <= 0) ? 0.1 : dt_raw;
+    const double started = this->has_last ? 1.0 : 0.0;
+
+    filter_axis(V, this->x[0], this->dx[0], dt, started, this->settings);
+    filter_axis(A, this->x[1], this->dx[1], dt, started, this->settings);
+    filter_axis(D, this->x[2], this->dx[2], dt, started, this->settings);
+
+    this->last_timestamp = timestamp;
+    this->has_last = true;
+    return VADPoint{V, A, D, timestamp};
+}
+
+// FilterBank ----------------------------------------------------------------------
+FilterBank::FilterBank(std::size_t streams, const filter_option& option)
+    : settings(option)
+{
+    check_option(option);
+    this->resize(streams);
+}
+
+void FilterBank::resize(std::size_t streams)
+{
+    this->last_timestamp.resize(streams, 0.0);
+    this->started.resize(streams, 0.0);
+    this->x_v.resize(streams, 0.0);
+    this->x_a.resize(streams, 0.0);
+    this->x_d.resize(streams, 0.0);
+    this->dx_v.resize(streams, 0.0);
+    this->dx_a.resize(streams, 0.0);
+    this->dx_d.resize(streams, 0.0);
+}
+
+void FilterBank::reset(std::size_t stream)
+{
+    this->started.at(stream) = 0.0;
+}
+
+void FilterBank::step(double* V, double* A, double* D, const double* timestamp)
+{
+    const std::size_t n = this->size();
+    const filter_option option = this->settings;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const double dt_raw = timestamp[i] - this->last_timestamp[i];
+        const double dt = (dt_raw <= 0) ? 0.1 : dt_raw;
+        const double started = this->started[i];
+
+        filter_axis(V[i], this->x_v[i], this->dx_v[i], dt, started, option);
+        filter_axis(A[i], this->x_a[i], this->dx_a[i], dt, started, option);
+        filter_axis(D[i], this->x_d[i], this->dx_d[i], dt, started, option);
+
+        this->last_timestamp[i] = timestamp[i];
+        this->started[i] = 1.0;
+    }
+}
+
+void FilterBank::step_some(const std::size_t* ids, std::size_t count, double* V, double* A, double* D, const double* timestamp)
+{
+    const std::size_t n = this->size();
+    const filter_option option = this->settings;
+    for (std::size_t k = 0; k < count; k++)
+    {
+        const std::size_t i = ids[k];
+        if (i >= n)
+            throw std::out_of_range("stream id is past the end of the FilterBank");
+
+        const double dt_raw = timestamp[k] - this->last_timestamp[i];
+        const double dt = (dt_raw <= 0) ? 0.1 : dt_raw;
+        const double started = this->started[i];
+
+        filter_axis(V[k], this->x_v[i], this->dx_v[i], dt, started, option);
+        filter_axis(A[k], this->x_a[i], this->dx_a[i], dt, started, option);
+        filter_axis(D[k], this->x_d[i], this->dx_d[i], dt, started, option);
+
+        this->last_timestamp[i] = timestamp[k];
+        this->started[i] = 1.0;
+    }
+}
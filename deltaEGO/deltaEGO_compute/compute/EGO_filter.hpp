@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "VAD.hpp"
+
+/*
+ * One-Euro filter (Casiez et al. 2012) for VAD vectors.
+ * A low-pass filter whose cutoff rises with speed: slow drift is smoothed hard (no jitter),
+ * real jumps pass with little lag. Per axis:
+ *   dx      = (x - x_prev) / dt, smoothed with cutoff d_cutoff
+ *   cutoff  = min_cutoff + beta * |dx|
+ *   x_hat  += alpha(cutoff) * (x - x_hat),   alpha = 1 / (1 + 1 / (2 pi cutoff dt))
+ * Cutoffs are in Hz of the timestamps (seconds). dt <= 0 counts as 0.1 s, like the kernels.
+ * The first sample passes through unchanged.
+ */
+
+// input struct-------------------------------------------------------------
+struct filter_option
+{
+    double min_cutoff = 0.01;   // Hz; lower = smoother at rest
+    double beta = 0.5;          // speed coefficient; higher = less lag on real changes
+    double d_cutoff = 1.0;      // Hz, for the speed estimate
+};
+// input struct-------------------------------------------------------------
+
+// one stream. Time complexity: O(1) per sample
+class OneEuroFilter
+{
+    public:
+    explicit OneEuroFilter(const filter_option& option = filter_option{});
+
+    VADPoint filter(double V, double A, double D, double timestamp);
+    void reset() { this->has_last = false; }
+    const filter_option& option() const { return this->settings; }
+
+    private:
+    filter_option settings;
+    bool has_last = false;
+    double last_timestamp = 0;
+    double x[3] = {};    // filtered V, A, D
+    double dx[3] = {};   // filtered speed
+};
+
+/*
+ * Many streams in structure-of-arrays form, so one tick over every stream is a flat,
+ * branch-free loop the compiler can vectorize.
+ * step():      sample i belongs to stream i (all streams, one tick)
+ * step_some(): sample i belongs to stream ids[i] (any subset, ids may not repeat in one call)
+ * Results are written over the input arrays.
+ * Time complexity: O(samples)
+ */
+class FilterBank
+{
+    public:
+    FilterBank(std::size_t streams, const filter_option& option = filter_option{});
+
+    void step(double* V, double* A, double* D, const double* timestamp);
+    void step_some(const std::size_t* ids, std::size_t count, double* V, double* A, double* D, const double* timestamp);
+    void reset(std::size_t stream);
+    std::size_t size() const { return this->last_timestamp.size(); }
+    void resize(std::size_t streams);   // new streams start empty
+
+    private:
+    filter_option settings;
+    std::vector<double> last_timestamp;
+    std::vector<double> started;        // 1.0 once a stream has a sample (a mask, not a branch)
+    std::vector<double> x_v, x_a, x_d;
+    std::vector<double> dx_v, dx_a, dx_d;
+};
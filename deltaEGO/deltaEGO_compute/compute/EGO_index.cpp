@@ -0,0 +1,114 @@
+#include "EGO_index.hpp"
+#include <algorithm>
+#include <cmath>
+
+HistoryIndex::HistoryIndex(const EGO_axis& base, const weight& w, const variable& v)
+    : params(make_interval_params(base, w, v)),
+      prefix_v{0.0}, prefix_a{0.0}, prefix_d{0.0}, prefix_sq{0.0}
+{
+}
+
+/*
+ * Builds the index of a whole history.
+ * Time complexity: O(n)
+ * Space complexity: O(n)
+ */
+HistoryIndex::HistoryIndex(const HistorySpan& history, const EGO_axis& base, const weight& w, const variable& v)
+    : HistoryIndex(base, w, v)
+{
+    this->reserve(history.size);
+    for (std::size_t i = 0; i < history.size; i++)
+        this->push(history.v_at(i), history.a_at(i), history.d_at(i), history.timestamp_at(i));
+}
+
+/*
+ * Appends one sample: one interval term and one row of each prefix column.
+ * Time complexity: O(1) amortized
+ */
+void HistoryIndex::push(double V, double A, double D, double ts)
+{
+    double stress = 0.0, reward = 0.0;
+    if (!this->timestamp.empty())
+    {
+        // dt from the raw timestamps (dt <= 0 counts as 0.1 like every other kernel)
+        Interval_Terms terms = get_sample_terms(V, A, D, ts - this->last_timestamp, this->params);
+        stress = this->prefix_stress.back() + terms.stress;
+        reward = this->prefix_reward.back() + terms.reward;
+    }
+    this->last_timestamp = ts;
+
+    // search key is clamped so the binary search stays valid
+    this->timestamp.push_back(this->timestamp.empty() ? ts : std::max(ts, this->timestamp.back()));
+    this->prefix_stress.push_back(stress);
+    this->prefix_reward.push_back(reward);
+
+    this->prefix_v.push_back(this->prefix_v.back() + V);
+    this->prefix_a.push_back(this->prefix_a.back() + A);
+    this->prefix_d.push_back(this->prefix_d.back() + D);
+    this->prefix_sq.push_back(this->prefix_sq.back() + V*V + A*A + D*D);
+}
+
+void HistoryIndex::reserve(std::size_t n)
+{
+    this->timestamp.reserve(n);
+    this->prefix_stress.reserve(n);
+    this->prefix_reward.reserve(n);
+    this->prefix_v.reserve(n + 1);
+    this->prefix_a.reserve(n + 1);
+    this->prefix_d.reserve(n + 1);
+    this->prefix_sq.reserve(n + 1);
+}
+
+void HistoryIndex::clear()
+{
+    this->timestamp.clear();
+    this->prefix_stress.clear();
+    this->prefix_reward.clear();
+    this->prefix_v.assign(1, 0.0);
+    this->prefix_a.assign(1, 0.0);
+    this->prefix_d.assign(1, 0.0);
+    this->prefix_sq.assign(1, 0.0);
+}
+
+// O(log n) ----------------------------------------------------------------------
+void HistoryIndex::find_range(double t0, double t1, std::size_t& first, std::size_t& last) const
+{
+    first = std::lower_bound(this->timestamp.begin(), this->timestamp.end(), t0) - this->timestamp.begin();
+    last = std::upper_bound(this->timestamp.begin(), this->timestamp.end(), t1) - this->timestamp.begin();
+    if (last < first)
+        last = first;   // t1 < t0
+}
+
+std::size_t HistoryIndex::count(double t0, double t1) const
+{
+    std::size_t first, last;
+    this->find_range(t0, t1, first, last);
+    return last - first;
+}
+
+/*
+ * This function returns cumulative metrics of the samples in [t0, t1].
+ * Time complexity: O(log n)
+ * Space complexity: O(1)
+ */
+CumulativeMetrics HistoryIndex::query(double t0, double t1) const
+{
+    std::size_t first, last;
+    this->find_range(t0, t1, first, last);
+
+    if (first == last)
+        return make_cumulative_metrics(VAD_ave{0.0, 0.0, 0.0, 0.05}, 0.0, 0.0);
+
+    const double n = static_cast<double>(last - first);
+    const double cx = (this->prefix_v[last] - this->prefix_v[first]) / n;
+    const double cy = (this->prefix_a[last] - this->prefix_a[first]) / n;
+    const double cz = (this->prefix_d[last] - this->prefix_d[first]) / n;
+    const double sq = (this->prefix_sq[last] - this->prefix_sq[first]) / n;
+    const double r = std::sqrt(std::max(0.0, sq - (cx*cx + cy*cy + cz*cz)));
+
+    // intervals (first -> first+1) ... (last-2 -> last-1)
+    const double stress = this->prefix_stress[last - 1] - this->prefix_stress[first];
+    const double reward = this->prefix_reward[last - 1] - this->prefix_reward[first];
+
+    return make_cumulative_metrics(VAD_ave{cx, cy, cz, r}, stress, reward);
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "EGO_compute.hpp"
+#include "EGO_kernel.hpp"
+
+/*
+ * Prefix sums over a history, keyed by timestamp.
+ * Cumulative stress / reward / ratios / center of any [t0, t1] come back in O(log n)
+ * (two binary searches + a few subtractions) instead of re-running EGO_compute on a slice.
+ *
+ * A range holds the samples with t0 <= timestamp <= t1. Like the window mode, an interval
+ * counts only if both of its ends are inside the range.
+ * The radius is the RMS distance to the center: the mean distance can't be prefix-summed.
+ * A timestamp older than the previous one (wall clock stepped back) doesn't throw: its interval
+ * counts as dt = 0.1 like in EGO_compute, and it is indexed at the previous timestamp.
+ */
+class HistoryIndex
+{
+    public:
+    HistoryIndex(const EGO_axis& base = EGO_axis{},
+                 const weight& w = weight{},
+                 const variable& v = variable{});
+    HistoryIndex(const HistorySpan& history,
+                 const EGO_axis& base = EGO_axis{},
+                 const weight& w = weight{},
+                 const variable& v = variable{});
+
+    // O(1) amortized
+    void push(double V, double A, double D, double ts);
+    void push(const VADPoint& point) { this->push(point.v, point.a, point.d, point.timestamp); }
+    void reserve(std::size_t n);
+    void clear();
+
+    // O(log n)
+    CumulativeMetrics query(double t0, double t1) const;
+    // samples with t0 <= timestamp <= t1
+    std::size_t count(double t0, double t1) const;
+
+    std::size_t size() const { return timestamp.size(); }
+    bool empty() const { return timestamp.empty(); }
+
+    private:
+    // [first, last) sample indices of [t0, t1]
+    void find_range(double t0, double t1, std::size_t& first, std::size_t& last) const;
+
+    Interval_Params params;
+
+    std::vector<double> timestamp;      // search keys, clamped to non-decreasing
+    double last_timestamp = 0.0;        // raw timestamp of the last push (for dt)
+
+    // prefix_x[i] = sum over samples [0, i), size n + 1
+    std::vector<double> prefix_v;
+    std::vector<double> prefix_a;
+    std::vector<double> prefix_d;
+    std::vector<double> prefix_sq;      // |x|^2
+    // prefix_stress[i] = sum of interval terms (0 -> 1) ... (i-1 -> i), size n
+    std::vector<double> prefix_stress;
+    std::vector<double> prefix_reward;
+};
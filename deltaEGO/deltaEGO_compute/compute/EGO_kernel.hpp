@@ -0,0 +1,212 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include "EGO_compute.hpp"
+
+// per-sample kernels shared by every O(n) / streaming path (header-only so they inline)
+
+/*
+ * Clamps x into [0, 1]. Every stress/reward model uses it, so the O(n) paths and the
+ * O(1) one (get_instant_terms) agree bit for bit.
+ * min/max on doubles lower to minsd/maxsd (minpd/maxpd in vectorized loops), so it doesn't branch.
+ * Time complexity: O(1)
+ */
+inline double clamp01(double x)
+{
+    return std::min(1.0, std::max(0.0, x));
+}
+
+// per-history constants of the stress/reward kernels
+struct Interval_Params
+{
+    double baseline_v;
+    double baseline_a;
+    double baseline_d;
+    double radius_pow2;     // stabilityRadius^2, or -1 if radius is negative
+    double dampening_factor;
+    double weightA_stress;
+    double weightV_stress;
+    double weightV_reward;
+    double weightA_reward;
+};
+
+struct Interval_Terms
+{
+    double stress;  // instant stress * dt
+    double reward;  // instant reward * dt
+};
+
+inline Interval_Params make_interval_params(const EGO_axis& base, const weight& w, const variable& v)
+{
+    return Interval_Params{
+        base.baseline.v, base.baseline.a, base.baseline.d,
+        (base.stabilityRadius >= 0.0) ? base.stabilityRadius * base.stabilityRadius : -1.0,
+        v.dampening_factor,
+        w.weightA_stress, w.weightV_stress,
+        w.weightV_reward, w.weightA_reward
+    };
+}
+
+/*
+ * Default stress/reward model: the linear weight formulas with the weights read at run time.
+ * Stress rises with low valence and high arousal, reward (dopamine) with high valence and high arousal.
+ * Other models (EGO_model.hpp) have the same shape, so every kernel below takes any of them
+ * as a template argument and the calls inline (no virtual call per sample).
+ */
+struct linear_model
+{
+    explicit linear_model(const Interval_Params& p)
+        : weightA_stress(p.weightA_stress), weightV_stress(p.weightV_stress),
+          weightV_reward(p.weightV_reward), weightA_reward(p.weightA_reward) {}
+
+    static bool matches(const Interval_Params&) { return true; }
+
+    double stress(double V, double A) const { return clamp01(weightV_stress * ((1.0 - V) / 2.0) + weightA_stress * A); }
+    double reward(double V, double A) const { return clamp01(weightV_reward * ((V + 1.0) / 2.0) + weightA_reward * A); }
+
+    double weightA_stress;
+    double weightV_stress;
+    double weightV_reward;
+    double weightA_reward;
+};
+
+/*
+ * Instant stress and reward of `current` under one model: stress is dampened while the
+ * distance to the baseline is within stabilityRadius. The O(1) half of EGO_compute.
+ * Time complexity: O(1)
+ */
+template <typename Model>
+inline Instant_Terms get_instant_terms(const VADPoint& current, double distance, double stabilityRadius,
+                                       double dampening_factor, const Model& model)
+{
+    const double damp = (distance <= stabilityRadius) ? dampening_factor : 1.0;
+    return Instant_Terms{ model.stress(current.v, current.a) * damp, model.reward(current.v, current.a) };
+}
+
+/*
+ * Stress * dt and reward * dt of one sample whose interval is dt_raw long.
+ * Same math as get_instant_terms, written branch-free:
+ *  - distance <= stabilityRadius is checked as distance^2 <= radius_pow2 (no sqrt),
+ *  - dt (non-positive -> 0.1) and dampening are selects, clamps use clamp01.
+ * Time complexity: O(1)
+ */
+template <typename Model>
+inline Interval_Terms get_model_terms(double V, double A, double D, double dt_raw, const Interval_Params& p, const Model& model)
+{
+    const double dt = (dt_raw <= 0) ? 0.1 : dt_raw;
+
+    const double bv = V - p.baseline_v;
+    const double ba = A - p.baseline_a;
+    const double bd = D - p.baseline_d;
+    const double damp = (bv*bv + ba*ba + bd*bd <= p.radius_pow2) ? p.dampening_factor : 1.0;
+
+    return Interval_Terms{ model.stress(V, A) * damp * dt, model.reward(V, A) * dt };
+}
+
+inline Interval_Terms get_sample_terms(double V, double A, double D, double dt_raw, const Interval_Params& p)
+{
+    return get_model_terms(V, A, D, dt_raw, p, linear_model(p));
+}
+
+/*
+ * get_model_terms for interval (j-1 -> j) of a history.
+ * Stride is std::integral_constant<size_t, 1> for contiguous columns (so the compiler
+ * sees unit stride and vectorizes) or a runtime size_t for strided views.
+ * Time complexity: O(1)
+ */
+template <typename Stride, typename Model>
+inline Interval_Terms get_interval_terms(const HistorySpan& history, std::size_t j, Stride stride, const Interval_Params& p,
+                                         const Model& model)
+{
+    return get_model_terms(history.v[j * stride],
+                           history.a[j * stride],
+                           history.d[j * stride],
+                           history.timestamp[j * stride] - history.timestamp[(j - 1) * stride],
+                           p, model);
+}
+
+template <typename Stride>
+inline Interval_Terms get_interval_terms(const HistorySpan& history, std::size_t j, Stride stride, const Interval_Params& p)
+{
+    return get_interval_terms(history, j, stride, p, linear_model(p));
+}
+
+// center sums + stress / reward integrals of a block of samples (pass 1 of the lifetime kernel)
+struct Block_Sums
+{
+    double v;
+    double a;
+    double d;
+    double stress;
+    double reward;
+};
+
+inline double lane_sum(const double (&lane)[4]) { return (lane[0] + lane[1]) + (lane[2] + lane[3]); }
+
+/*
+ * Pass 1 over samples [begin, end): center sums + stress integral + reward integral.
+ * Time complexity: O(end - begin)
+ * Space complexity: O(1)
+ */
+template <typename Stride, typename Model>
+Block_Sums history_block_sums(const HistorySpan& history, std::size_t begin, std::size_t end, Stride stride,
+                              const Interval_Params& params, const Model& model)
+{
+    const double* xs = history.v;
+    const double* ys = history.a;
+    const double* zs = history.d;
+
+    // sample 0 has no interval
+    double head_v = 0, head_a = 0, head_d = 0;
+    std::size_t i = begin;
+    if (begin == 0)
+    {
+        head_v = xs[0]; head_a = ys[0]; head_d = zs[0];
+        i = 1;
+    }
+
+    double lane_v[4] = {}, lane_a[4] = {}, lane_d[4] = {}, lane_stress[4] = {}, lane_reward[4] = {};
+    for (; i + 4 <= end; i += 4)
+    {
+        for (std::size_t l = 0; l < 4; l++)
+        {
+            lane_v[l] += xs[(i + l) * stride];
+            lane_a[l] += ys[(i + l) * stride];
+            lane_d[l] += zs[(i + l) * stride];
+
+            Interval_Terms terms = get_interval_terms(history, i + l, stride, params, model);
+            lane_stress[l] += terms.stress;
+            lane_reward[l] += terms.reward;
+        }
+    }
+    for (; i < end; i++)
+    {
+        lane_v[0] += xs[i * stride];
+        lane_a[0] += ys[i * stride];
+        lane_d[0] += zs[i * stride];
+
+        Interval_Terms terms = get_interval_terms(history, i, stride, params, model);
+        lane_stress[0] += terms.stress;
+        lane_reward[0] += terms.reward;
+    }
+
+    return Block_Sums{ head_v + lane_sum(lane_v), head_a + lane_sum(lane_a), head_d + lane_sum(lane_d),
+                       lane_sum(lane_stress), lane_sum(lane_reward) };
+}
+
+/*
+ * Packs center/radius and the two integrals into CumulativeMetrics (ratios like get_stress_reward_ratio).
+ * Time complexity: O(1)
+ */
+inline CumulativeMetrics make_cumulative_metrics(const VAD_ave& average_area, double stress, double reward)
+{
+    CumulativeMetrics out;
+    out.average_area = average_area;
+    out.stress = stress;
+    out.reward = reward;
+    out.total = stress + reward;
+    out.stress_ratio = (out.total > 1e-9) ? stress / out.total : 0.0;
+    out.reward_ratio = (out.total > 1e-9) ? reward / out.total : 0.0;
+    return out;
+}
@@ -0,0 +1,265 @@
+#include "EGO_log.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    // file layout ---------------------------------------------------------------
+    const char LOG_MAGIC[8] = {'D', 'E', 'G', 'O', 'L', 'O', 'G', '1'};
+    const std::uint32_t LOG_VERSION = 1;
+
+    struct LogHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t record_size;
+        char reserved[48];
+    };
+    static_assert(sizeof(LogHeader) == 64, "header keeps records 8-byte aligned");
+
+    std::runtime_error os_error(const std::string& what, const std::string& path)
+    {
+        return std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+    }
+
+    void write_all(int fd, const void* data, std::size_t bytes, const std::string& path)
+    {
+        const char* p = static_cast<const char*>(data);
+        while (bytes > 0)
+        {
+            const ssize_t n = ::write(fd, p, bytes);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                throw os_error("HistoryLog: write failed", path);
+            }
+            p += n;
+            bytes -= static_cast<std::size_t>(n);
+        }
+    }
+}
+
+/*
+ * Opens (or creates) the log and its owner sidecar.
+ * Time complexity: O(owners) (records are mapped, not read)
+ */
+HistoryLog::HistoryLog(const std::string& path, std::size_t sync_every)
+    : file_path(path), sync_every(sync_every == 0 ? 1 : sync_every)
+{
+    this->fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (this->fd < 0)
+        throw os_error("HistoryLog: cannot open", path);
+
+    struct stat st;
+    if (::fstat(this->fd, &st) != 0)
+    {
+        ::close(this->fd);
+        throw os_error("HistoryLog: cannot stat", path);
+    }
+
+    std::size_t file_size = static_cast<std::size_t>(st.st_size);
+    if (file_size == 0)
+    {
+        // new log
+        LogHeader header{};
+        std::memcpy(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC));
+        header.version = LOG_VERSION;
+        header.record_size = sizeof(LogRecord);
+        write_all(this->fd, &header, sizeof(header), path);
+        ::fsync(this->fd);
+        file_size = sizeof(header);
+    }
+    else
+    {
+        LogHeader header{};
+        if (file_size < sizeof(header) || ::pread(this->fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))
+            || std::memcmp(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0)
+        {
+            ::close(this->fd);
+            throw std::runtime_error("HistoryLog: '" + path + "' is not a deltaEGO history log");
+        }
+        if (header.version != LOG_VERSION || header.record_size != sizeof(LogRecord))
+        {
+            ::close(this->fd);
+            throw std::runtime_error("HistoryLog: '" + path + "' has an unsupported version or record size");
+        }
+
+        // torn tail from a crash mid-append
+        const std::size_t whole = sizeof(LogHeader) + (file_size - sizeof(LogHeader)) / sizeof(LogRecord) * sizeof(LogRecord);
+        if (whole != file_size)
+        {
+            if (::ftruncate(this->fd, static_cast<off_t>(whole)) != 0)
+            {
+                ::close(this->fd);
+                throw os_error("HistoryLog: cannot truncate torn record in", path);
+            }
+            file_size = whole;
+        }
+    }
+
+    this->count = (file_size - sizeof(LogHeader)) / sizeof(LogRecord);
+    try
+    {
+        this->open_owners();
+    }
+    catch (...)
+    {
+        ::close(this->fd);
+        throw;
+    }
+}
+
+HistoryLog::~HistoryLog()
+{
+    try { this->flush(); } catch (...) {}
+
+    if (this->current.address)
+        ::munmap(this->current.address, this->current.length);
+    for (const Mapping& m : this->retired)
+        ::munmap(m.address, m.length);
+
+    if (this->owners_fd >= 0)
+        ::close(this->owners_fd);
+    if (this->fd >= 0)
+        ::close(this->fd);
+}
+
+void HistoryLog::open_owners()
+{
+    const std::string owners_path = this->file_path + ".owners";
+
+    std::ifstream in(owners_path);
+    for (std::string line; std::getline(in, line); )
+        this->owner_names.push_back(line);
+
+    this->owners_fd = ::open(owners_path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (this->owners_fd < 0)
+        throw os_error("HistoryLog: cannot open", owners_path);
+}
+
+//--------------------appending--------------------
+void HistoryLog::append(const VADPoint& point)
+{
+    this->append(point.v, point.a, point.d, point.timestamp, this->intern_owner(point.owner));
+}
+
+/*
+ * Writes one record (O_APPEND: one write() per record, never interleaved).
+ * Time complexity: O(1), plus one fsync every `sync_every` calls
+ */
+void HistoryLog::append(double V, double A, double D, double ts, std::uint32_t owner_id)
+{
+    if (owner_id >= this->owner_names.size())
+        throw std::out_of_range("owner id is not interned in this log");
+
+    const LogRecord record{V, A, D, ts, owner_id};
+    write_all(this->fd, &record, sizeof(record), this->file_path);
+    this->count++;
+
+    if (++this->unsynced >= this->sync_every)
+        this->flush();
+}
+
+std::uint32_t HistoryLog::intern_owner(const std::string& owner)
+{
+    for (std::size_t i = 0; i < this->owner_names.size(); i++)
+    {
+        if (this->owner_names[i] == owner)
+            return static_cast<std::uint32_t>(i);
+    }
+
+    if (owner.find('\n') != std::string::npos)
+        throw std::invalid_argument("owner name can't contain a newline");
+
+    // sidecar first: a record must never point at an owner that isn't on disk
+    const std::string line = owner + "\n";
+    write_all(this->owners_fd, line.data(), line.size(), this->file_path + ".owners");
+    ::fsync(this->owners_fd);
+
+    this->owner_names.push_back(owner);
+    return static_cast<std::uint32_t>(this->owner_names.size() - 1);
+}
+
+void HistoryLog::flush()
+{
+    if (this->unsynced == 0)
+        return;
+
+    if (::fsync(this->fd) != 0)
+        throw os_error("HistoryLog: fsync failed", this->file_path);
+    this->unsynced = 0;
+}
+
+//--------------------reading--------------------
+/*
+ * Maps the file with room to grow (doubling), so per-turn appends rarely remap.
+ * Pages past the end of the file are never read: callers only touch [0, count).
+ * Old mappings are kept (not unmapped) so spans handed out earlier stay valid.
+ * Time complexity: O(1) amortized
+ */
+void HistoryLog::ensure_mapped(std::size_t bytes) const
+{
+    if (bytes <= this->current.length)
+        return;
+
+    std::size_t length = (this->current.length > 0) ? this->current.length : 4096;
+    while (length < bytes)
+        length *= 2;
+
+    void* address = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, this->fd, 0);
+    if (address == MAP_FAILED)
+        throw os_error("HistoryLog: mmap failed", this->file_path);
+
+    if (this->current.address)
+        this->retired.push_back(this->current);
+    this->current = Mapping{address, length};
+}
+
+const LogRecord* HistoryLog::records() const
+{
+    this->ensure_mapped(sizeof(LogHeader) + this->count * sizeof(LogRecord));
+    return reinterpret_cast<const LogRecord*>(static_cast<const char*>(this->current.address) + sizeof(LogHeader));
+}
+
+HistorySpan HistoryLog::span() const
+{
+    const LogRecord* first = this->records();
+    return HistorySpan{&first->v, &first->a, &first->d, &first->timestamp,
+                       this->count, sizeof(LogRecord) / sizeof(double)};
+}
+
+VADPoint HistoryLog::at(std::size_t i) const
+{
+    if (i >= this->count)
+        throw std::out_of_range("history index out of range");
+
+    const LogRecord& r = this->records()[i];
+    const std::string owner = (r.owner_id < this->owner_names.size()) ? this->owner_names[r.owner_id] : std::string();
+    return VADPoint{r.v, r.a, r.d, r.timestamp, owner};
+}
+
+/*
+ * Time complexity: O(n)
+ * Space complexity: O(n)
+ */
+VADHistory HistoryLog::to_history() const
+{
+    VADHistory history;
+    history.reserve(this->count);
+
+    // same ids in both: intern in order
+    for (const std::string& name : this->owner_names)
+        history.intern_owner(name);
+
+    const LogRecord* r = this->records();
+    for (std::size_t i = 0; i < this->count; i++)
+        history.push_back(r[i].v, r[i].a, r[i].d, r[i].timestamp, static_cast<std::uint32_t>(r[i].owner_id));
+    return history;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "VAD.hpp"
+#include "VAD_history.hpp"
+
+/*
+ * One sample on disk: 40 bytes, all 8-byte fields, so the mapped file reads
+ * directly as a HistorySpan with stride 5 (no parsing on reopen).
+ * Byte order is the host's; logs are not meant to move between architectures.
+ */
+struct LogRecord
+{
+    double v;
+    double a;
+    double d;
+    double timestamp;
+    std::uint64_t owner_id;
+};
+static_assert(sizeof(LogRecord) == 5 * sizeof(double), "LogRecord must stay 40 bytes");
+
+/*
+ * Append-only binary history of one character.
+ *  <path>         64-byte header + LogRecord[]
+ *  <path>.owners  owner names, one per line (line i = owner id i)
+ *
+ * Appends go straight to the file (a crashed process loses nothing), fsync runs every
+ * `sync_every` appends and on flush()/destruction. Reading goes through a read-only
+ * shared mmap, so a restarted process gets its history back in O(1).
+ * A torn last record (crash mid-write) is cut off on open.
+ * POSIX only (open/mmap/fsync).
+ */
+class HistoryLog
+{
+    public:
+    explicit HistoryLog(const std::string& path, std::size_t sync_every = 64);
+    ~HistoryLog();
+
+    HistoryLog(const HistoryLog&) = delete;
+    HistoryLog& operator=(const HistoryLog&) = delete;
+
+    //--------------------appending--------------------
+    void append(const VADPoint& point);
+    void append(double V, double A, double D, double ts, std::uint32_t owner_id);
+    // returns id of owner name, writes it to the sidecar if it's new
+    std::uint32_t intern_owner(const std::string& owner);
+    // fsync the records and the owner list
+    void flush();
+
+    //--------------------reading--------------------
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const std::string& path() const { return file_path; }
+
+    // records [0, size()) in the mapping; valid until the log is destroyed
+    const LogRecord* records() const;
+    // view for EGO_compute (stride 5); valid until the log is destroyed
+    HistorySpan span() const;
+    VADPoint at(std::size_t i) const;
+    // copies into memory (for callers that need a VADHistory)
+    VADHistory to_history() const;
+
+    const std::string& owner_name(std::uint32_t owner_id) const { return owner_names.at(owner_id); }
+    const std::vector<std::string>& owners() const { return owner_names; }
+
+    private:
+    struct Mapping
+    {
+        void* address;
+        std::size_t length;
+    };
+
+    void open_owners();
+    // maps at least `bytes` of the file; older mappings stay valid until destruction
+    void ensure_mapped(std::size_t bytes) const;
+
+    std::string file_path;
+    std::size_t sync_every;
+    std::size_t unsynced = 0;
+
+    int fd = -1;
+    int owners_fd = -1;
+    std::size_t count = 0;
+    std::vector<std::string> owner_names;
+
+    mutable Mapping current{nullptr, 0};
+    mutable std::vector<Mapping> retired;
+};
@@ -0,0 +1,168 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "EGO_kernel.hpp"
+
+/*
+ * Compile-time stress/reward models for the hot per-sample loops.
+ * A model is a plain struct (no virtual functions) with
+ *  - explicit Model(const Interval_Params&)
+ *  - static bool matches(const Interval_Params&)   true when this model may replace linear_model
+ *  - double stress(double V, double A) const       undamped instant stress in [0, 1]
+ *  - double reward(double V, double A) const       instant reward in [0, 1]
+ * with_stress_model picks one model per history, and the kernel is instantiated for it,
+ * so the inner loop calls it inline. linear_model (EGO_kernel.hpp) is the fallback.
+ */
+
+// presets ---------------------------------------------------------------------------
+/*
+ * Weights fixed at compile time. With constexpr weights the compiler folds the
+ * multiplications into the loop body and keeps no weight registers live.
+ * Results are bitwise equal to linear_model with the same weights.
+ */
+template <typename Preset>
+struct preset_model
+{
+    explicit preset_model(const Interval_Params&) {}
+
+    static bool matches(const Interval_Params& p)
+    {
+        return p.weightA_stress == Preset::weightA_stress && p.weightV_stress == Preset::weightV_stress &&
+               p.weightV_reward == Preset::weightV_reward && p.weightA_reward == Preset::weightA_reward;
+    }
+
+    double stress(double V, double A) const { return clamp01(Preset::weightV_stress * ((1.0 - V) / 2.0) + Preset::weightA_stress * A); }
+    double reward(double V, double A) const { return clamp01(Preset::weightV_reward * ((V + 1.0) / 2.0) + Preset::weightA_reward * A); }
+};
+
+// weight{} defaults (most histories never override them)
+struct default_weight_preset
+{
+    static constexpr double weightA_stress = weight{}.weightA_stress;
+    static constexpr double weightV_stress = weight{}.weightV_stress;
+    static constexpr double weightV_reward = weight{}.weightV_reward;
+    static constexpr double weightA_reward = weight{}.weightA_reward;
+};
+
+// persona presets: same scale as the defaults (each pair sums to 1), different balance
+// arousal drives stress
+struct anxious_weight_preset
+{
+    static constexpr double weightA_stress = 0.85;
+    static constexpr double weightV_stress = 0.15;
+    static constexpr double weightV_reward = 0.5;
+    static constexpr double weightA_reward = 0.5;
+};
+
+// low valence drives stress, reward comes mostly from valence
+struct melancholic_weight_preset
+{
+    static constexpr double weightA_stress = 0.3;
+    static constexpr double weightV_stress = 0.7;
+    static constexpr double weightV_reward = 0.7;
+    static constexpr double weightA_reward = 0.3;
+};
+
+// arousal is rewarding more than stressful
+struct thrill_seeker_weight_preset
+{
+    static constexpr double weightA_stress = 0.4;
+    static constexpr double weightV_stress = 0.6;
+    static constexpr double weightV_reward = 0.25;
+    static constexpr double weightA_reward = 0.75;
+};
+
+// the weights a preset stands for: pass them as compute_in.weights to get the preset kernel
+template <typename Preset>
+constexpr weight preset_weight()
+{
+    return weight{Preset::weightA_stress, Preset::weightV_stress, Preset::weightV_reward, Preset::weightA_reward,
+                  weight{}.weight_k};
+}
+
+// registry --------------------------------------------------------------------------
+template <typename... Models>
+struct model_list {};
+
+/*
+ * Models tried in order by with_stress_model (O(1) terms, lifetime kernel, series).
+ * Every kernel that dispatches through it gets one specialized instantiation per entry.
+ * A model only one caller needs doesn't go here: use EGO_compute<Model> below.
+ */
+using stress_models = model_list<preset_model<default_weight_preset>,
+                                 preset_model<anxious_weight_preset>,
+                                 preset_model<melancholic_weight_preset>,
+                                 preset_model<thrill_seeker_weight_preset>>;
+
+template <typename Func>
+decltype(auto) dispatch_stress_model(const Interval_Params& p, Func&& func, model_list<>)
+{
+    return std::forward<Func>(func)(linear_model(p));
+}
+
+template <typename Func, typename Model, typename... Rest>
+decltype(auto) dispatch_stress_model(const Interval_Params& p, Func&& func, model_list<Model, Rest...>)
+{
+    if (Model::matches(p))
+        return std::forward<Func>(func)(Model(p));
+    return dispatch_stress_model(p, std::forward<Func>(func), model_list<Rest...>{});
+}
+
+/*
+ * Calls func(model) with the first registered model that matches p (linear_model otherwise).
+ * func is a generic lambda, so one branch per history picks the instantiation.
+ * Time complexity: O(registered models)
+ */
+template <typename Func>
+decltype(auto) with_stress_model(const Interval_Params& p, Func&& func)
+{
+    return dispatch_stress_model(p, std::forward<Func>(func), stress_models{});
+}
+
+// caller models ---------------------------------------------------------------------
+/*
+ * A model's two kernels as plain function pointers, so EGO_compute.cpp can run a model it
+ * wasn't compiled with. Both are instantiated in the caller's translation unit: the
+ * per-sample loop inlines the model, the pointer is called once per REDUCE_BLOCK samples.
+ */
+struct model_kernels
+{
+    Instant_Terms (*instant)(const VADPoint& current, double distance, double stabilityRadius, const Interval_Params& params);
+    Block_Sums (*block_sums)(const HistorySpan& history, std::size_t begin, std::size_t end, const Interval_Params& params);
+};
+
+template <typename Model>
+Instant_Terms model_instant_terms(const VADPoint& current, double distance, double stabilityRadius, const Interval_Params& params)
+{
+    return get_instant_terms(current, distance, stabilityRadius, params.dampening_factor, Model(params));
+}
+
+template <typename Model>
+Block_Sums model_block_sums(const HistorySpan& history, std::size_t begin, std::size_t end, const Interval_Params& params)
+{
+    const Model model(params);
+    if (history.stride == 1)
+        return history_block_sums(history, begin, end, std::integral_constant<std::size_t, 1>{}, params, model);
+    return history_block_sums(history, begin, end, history.stride, params, model);
+}
+
+template <typename Model>
+constexpr model_kernels make_model_kernels()
+{
+    return model_kernels{&model_instant_terms<Model>, &model_block_sums<Model>};
+}
+
+// EGO_compute with `kernels` instead of the registered models (lifetime cumulative only, else std::invalid_argument)
+AnalysisResult EGO_compute(const compute_in& user_in, const model_kernels& kernels);
+
+/*
+ * EGO_compute<Model>(bundle): instant stress / reward and the lifetime integrals come from Model
+ * (a struct like the ones above; matches() is not needed), without adding it to stress_models.
+ * Time complexity: O(n / threads)
+ */
+template <typename Model>
+AnalysisResult EGO_compute(const compute_in& user_in)
+{
+    return EGO_compute(user_in, make_model_kernels<Model>());
+}
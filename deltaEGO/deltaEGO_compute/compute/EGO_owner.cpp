@@ -0,0 +1,126 @@
+#include "EGO_owner.hpp"
+#include <cmath>
+#include <stdexcept>
+#include "EGO_kernel.hpp"
+
+namespace
+{
+    struct Owner_Sums
+    {
+        std::size_t count = 0;
+        std::size_t last = 0;       // index of the newest sample
+        std::size_t before_last = 0;
+        double v = 0, a = 0, d = 0;
+        double stress = 0, reward = 0;
+        double radius = 0;
+    };
+}
+
+std::vector<VADHistory::OwnerRun> make_owner_runs(const std::uint32_t* owner_ids, std::size_t n)
+{
+    std::vector<VADHistory::OwnerRun> runs;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        if (runs.empty() || runs.back().owner_id != owner_ids[i])
+            runs.push_back(VADHistory::OwnerRun{i, owner_ids[i]});
+    }
+    return runs;
+}
+
+std::vector<OwnerAnalysis> EGO_compute_by_owner(const VADHistory& history,
+                                                const std::optional<EGO_axis>& emotion_base,
+                                                const std::optional<variable>& variables,
+                                                const std::optional<weight>& weights,
+                                                math_precision precision)
+{
+    return EGO_compute_by_owner(history.span(), history.owner_runs(), history.owners(), emotion_base, variables, weights, precision);
+}
+
+std::vector<OwnerAnalysis> EGO_compute_by_owner(const HistorySpan& history,
+                                                const std::vector<VADHistory::OwnerRun>& runs,
+                                                const std::vector<std::string>& owner_names,
+                                                const std::optional<EGO_axis>& emotion_base,
+                                                const std::optional<variable>& variables,
+                                                const std::optional<weight>& weights,
+                                                math_precision precision)
+{
+    const Interval_Params params = make_interval_params(emotion_base.value_or(EGO_axis{}),
+                                                        weights.value_or(weight{}),
+                                                        variables.value_or(variable{}));
+    std::vector<Owner_Sums> owners(owner_names.size());
+
+    auto run_end = [&](std::size_t r) { return (r + 1 < runs.size()) ? runs[r + 1].start : history.size; };
+
+    // pass 1: center sums + integrals, an owner's first sample in a run continues from its last one
+    for (std::size_t r = 0; r < runs.size(); r++)
+    {
+        if (runs[r].owner_id >= owners.size())
+            throw std::out_of_range("owner id has no name");
+
+        Owner_Sums& sums = owners[runs[r].owner_id];
+        for (std::size_t i = runs[r].start; i < run_end(r); i++)
+        {
+            sums.v += history.v_at(i);
+            sums.a += history.a_at(i);
+            sums.d += history.d_at(i);
+
+            if (sums.count > 0)
+            {
+                Interval_Terms terms = get_sample_terms(history.v_at(i), history.a_at(i), history.d_at(i),
+                                                        history.timestamp_at(i) - history.timestamp_at(sums.last), params);
+                sums.stress += terms.stress;
+                sums.reward += terms.reward;
+            }
+
+            sums.before_last = sums.last;
+            sums.last = i;
+            sums.count++;
+        }
+    }
+
+    for (Owner_Sums& sums : owners)
+    {
+        if (sums.count == 0)
+            continue;
+        const double n = static_cast<double>(sums.count);
+        sums.v /= n; sums.a /= n; sums.d /= n;
+    }
+
+    // pass 2: mean radius around each owner's center
+    for (std::size_t r = 0; r < runs.size(); r++)
+    {
+        Owner_Sums& sums = owners[runs[r].owner_id];
+        for (std::size_t i = runs[r].start; i < run_end(r); i++)
+        {
+            const double dx = sums.v - history.v_at(i);
+            const double dy = sums.a - history.a_at(i);
+            const double dz = sums.d - history.d_at(i);
+            sums.radius += std::sqrt(dx*dx + dy*dy + dz*dz);
+        }
+    }
+
+    std::vector<OwnerAnalysis> results;
+    for (std::size_t id = 0; id < owners.size(); id++)
+    {
+        const Owner_Sums& sums = owners[id];
+        if (sums.count == 0)
+            continue;
+
+        VADPoint current = history.point(sums.last);
+        current.owner = owner_names[id];
+        std::optional<VADPoint> prev;
+        if (sums.count > 1)
+        {
+            prev = history.point(sums.before_last);
+            prev->owner = owner_names[id];
+        }
+
+        // O(1) part only (empty history), cumulative comes from the sums above
+        AnalysisResult analysis = EGO_compute_sync(current, HistorySpan{}, prev, emotion_base, variables, weights, precision);
+        const VAD_ave area{sums.v, sums.a, sums.d, sums.radius / static_cast<double>(sums.count)};
+        analysis.cumulative = make_cumulative_metrics(area, sums.stress, sums.reward);
+
+        results.push_back(OwnerAnalysis{owner_names[id], sums.count, analysis});
+    }
+    return results;
+}
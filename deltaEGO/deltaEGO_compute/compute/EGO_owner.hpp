@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include "EGO_compute.hpp"
+#include "VAD_history.hpp"
+
+// return struct------------------------------------------------------------
+struct OwnerAnalysis
+{
+    std::string owner;
+    std::size_t count;          // samples of this owner
+    AnalysisResult analysis;
+};
+// return struct------------------------------------------------------------
+
+/*
+ * One AnalysisResult per owner of a mixed history, same numbers as splitting the
+ * history per owner and calling EGO_compute on each part:
+ *  - an owner's intervals run between its own consecutive samples,
+ *  - current / prev are the owner's last two samples.
+ * Owner runs are walked once for center + integrals, once more for the radii.
+ * Every owner shares emotion_base / variables / weights; cumulative is lifetime.
+ * precision picks atan2 / exp of the lability (EGO_fastmath.hpp).
+ * Results are in owner id order (first appearance); owners without samples are skipped.
+ * Time complexity: O(n + owners)
+ * Space complexity: O(owners)
+ */
+std::vector<OwnerAnalysis> EGO_compute_by_owner(const VADHistory& history,
+                                                const std::optional<EGO_axis>& emotion_base,
+                                                const std::optional<variable>& variables,
+                                                const std::optional<weight>& weights,
+                                                math_precision precision = math_precision::exact);
+
+// same for any column view: owner runs and names come from the caller
+std::vector<OwnerAnalysis> EGO_compute_by_owner(const HistorySpan& history,
+                                                const std::vector<VADHistory::OwnerRun>& runs,
+                                                const std::vector<std::string>& owner_names,
+                                                const std::optional<EGO_axis>& emotion_base,
+                                                const std::optional<variable>& variables,
+                                                const std::optional<weight>& weights,
+                                                math_precision precision = math_precision::exact);
+
+// run-length encodes a per-sample owner id column (for numpy / file sources)
+std::vector<VADHistory::OwnerRun> make_owner_runs(const std::uint32_t* owner_ids, std::size_t n);
@@ -0,0 +1,72 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+/*
+ * Returns how many workers to use. 0 means "every hardware thread".
+ * Never returns more workers than there are jobs.
+ */
+inline unsigned int resolve_thread_count(unsigned int threads, std::size_t jobs)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    if (jobs < threads)
+        threads = static_cast<unsigned int>(std::max<std::size_t>(1, jobs));
+
+    return threads;
+}
+
+/*
+ * Runs func(i) for every i in [0, count) on a small pool of std::async workers.
+ * Workers pull chunks of `grain` indices from a shared counter, so uneven jobs
+ * (short and long histories mixed) still balance out.
+ * The calling thread works too, and exceptions are rethrown from get().
+ * Time complexity: O(count / threads) per worker
+ * Space complexity: O(threads)
+ */
+template <typename Func>
+void parallel_for(std::size_t count, unsigned int threads, Func&& func, std::size_t grain = 16)
+{
+    if (count == 0)
+        return;
+
+    threads = resolve_thread_count(threads, (count + grain - 1) / grain);
+
+    // not worth a thread
+    if (threads <= 1)
+    {
+        for (std::size_t i = 0; i < count; i++)
+            func(i);
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]()
+    {
+        while (true)
+        {
+            std::size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+            if (begin >= count)
+                return;
+
+            std::size_t end = std::min(count, begin + grain);
+            for (std::size_t i = begin; i < end; i++)
+                func(i);
+        }
+    };
+
+    std::vector<std::future<void>> workers;
+    workers.reserve(threads - 1);
+    for (unsigned int t = 1; t < threads; t++)
+        workers.push_back(std::async(std::launch::async, worker));
+
+    worker();
+
+    for (auto& w : workers)
+        w.get();
+}
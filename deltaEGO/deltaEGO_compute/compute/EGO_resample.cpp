@@ -0,0 +1,48 @@
+#include "EGO_resample.hpp"
+
+std::size_t resampled_size(const HistorySpan& history, const resample_option& option)
+{
+    std::size_t count = 0;
+    resample_history(history, option, [&](double, double, double, double) { count++; });
+    return count;
+}
+
+CumulativeMetrics calculate_resampled_cumulative(const HistorySpan& history, const Interval_Params& params,
+                                                 const resample_option& option)
+{
+    // if history is empty
+    if (history.size == 0)
+        return make_cumulative_metrics(VAD_ave{0.0, 0.0, 0.0, 0.05}, 0.0, 0.0);
+
+    const double step = option.step;
+
+    // pass 1: center sums + integrals; the first grid point has no interval
+    std::size_t count = 0;
+    double sum_v = 0, sum_a = 0, sum_d = 0;
+    double stress = 0, reward = 0;
+    resample_history(history, option, [&](double V, double A, double D, double)
+    {
+        sum_v += V; sum_a += A; sum_d += D;
+        if (count > 0)
+        {
+            Interval_Terms terms = get_sample_terms(V, A, D, step, params);
+            stress += terms.stress;
+            reward += terms.reward;
+        }
+        count++;
+    });
+
+    const double v = sum_v / count;
+    const double a = sum_a / count;
+    const double d = sum_d / count;
+
+    // pass 2: mean distance to the center
+    double radius_sum = 0;
+    resample_history(history, option, [&](double V, double A, double D, double)
+    {
+        const double dx = v - V, dy = a - A, dz = d - D;
+        radius_sum += std::sqrt(dx*dx + dy*dy + dz*dz);
+    });
+
+    return make_cumulative_metrics(VAD_ave{v, a, d, radius_sum / count}, stress, reward);
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include "EGO_compute.hpp"
+#include "EGO_kernel.hpp"
+
+/*
+ * Resampling of irregular histories onto a uniform time grid t_k = t_0 + k * step.
+ * Bursts of messages and long gaps both become evenly spaced samples, so every
+ * interval of the cumulative kernels is exactly `step` long.
+ *  - linear: straight line between the two samples around t_k,
+ *  - hold:   value of the last sample at or before t_k (zero-order hold).
+ * Timestamps are expected to be non-decreasing; a sample older than the previous one
+ * is treated as arriving at the previous timestamp.
+ * One gap emits at most max_gap_points grid points: the start of a longer gap is skipped
+ * (a first sample at timestamp 0 followed by unix time, a week of idle time ...),
+ * so the output stays O(n * max_gap_points) whatever the timestamps are.
+ */
+
+// input struct---------------------------------------------------------------------
+struct resample_option
+{
+    double step = 1.0;                              // grid spacing, same unit as timestamp
+    resample_mode mode = resample_mode::linear;
+    std::size_t max_gap_points = 10000;             // grid points per gap at most, 0 = no limit
+};
+// input struct---------------------------------------------------------------------
+
+/*
+ * Streaming resampler: push samples in time order, every grid point is handed to
+ * emit(v, a, d, t) as soon as it is known. Nothing is buffered besides the last sample.
+ * push: O(1 + grid points emitted), memory: O(1)
+ */
+class Resampler
+{
+    public:
+    explicit Resampler(const resample_option& option = resample_option{})
+        : option(option)
+    {
+        if (!(option.step > 0.0) || !std::isfinite(option.step))
+            throw std::invalid_argument("resample step must be a positive finite number");
+    }
+
+    template <typename Emit>
+    void push(double V, double A, double D, double timestamp, Emit&& emit)
+    {
+        if (!this->has_last)
+        {
+            this->origin = timestamp;
+            this->last_v = V; this->last_a = A; this->last_d = D; this->last_t = timestamp;
+            this->has_last = true;
+
+            emit(V, A, D, timestamp);
+            this->next = 1;
+            return;
+        }
+
+        const double t = (timestamp > this->last_t) ? timestamp : this->last_t;
+        const double span = t - this->last_t;
+
+        // cap the gap: skip ahead to the last max_gap_points grid points before t
+        if (this->option.max_gap_points > 0)
+        {
+            const double last_k = std::floor((t - this->origin) / this->option.step);
+            const double first_k = last_k + 1.0 - static_cast<double>(this->option.max_gap_points);
+            if (first_k > static_cast<double>(this->next))
+                this->next = static_cast<std::size_t>(first_k);
+        }
+
+        // grid times come from the index, so long runs don't accumulate rounding drift
+        for (double g = this->grid_time(this->next); g <= t; g = this->grid_time(++this->next))
+        {
+            if (this->option.mode == resample_mode::hold || span <= 0.0)
+            {
+                const bool reached = (g >= t);
+                emit(reached ? V : this->last_v, reached ? A : this->last_a, reached ? D : this->last_d, g);
+            }
+            else
+            {
+                const double w = (g - this->last_t) / span;
+                emit(this->last_v + (V - this->last_v) * w,
+                     this->last_a + (A - this->last_a) * w,
+                     this->last_d + (D - this->last_d) * w,
+                     g);
+            }
+        }
+
+        this->last_v = V; this->last_a = A; this->last_d = D; this->last_t = t;
+    }
+
+    void reset() { this->has_last = false; this->next = 0; }
+    double step() const { return this->option.step; }
+
+    private:
+    double grid_time(std::size_t k) const { return this->origin + static_cast<double>(k) * this->option.step; }
+
+    resample_option option;
+
+    bool has_last = false;
+    double origin = 0;
+    std::size_t next = 0;       // index of the next grid point to emit
+    double last_v = 0, last_a = 0, last_d = 0, last_t = 0;
+};
+
+/*
+ * Streams every sample of `history` through a Resampler.
+ * Time complexity: O(n + grid points)
+ * Space complexity: O(1)
+ */
+template <typename Emit>
+void resample_history(const HistorySpan& history, const resample_option& option, Emit&& emit)
+{
+    Resampler resampler(option);
+    for (std::size_t i = 0; i < history.size; i++)
+        resampler.push(history.v_at(i), history.a_at(i), history.d_at(i), history.timestamp_at(i), emit);
+}
+
+// number of grid points resample_history emits (sizes an output buffer up front)
+std::size_t resampled_size(const HistorySpan& history, const resample_option& option);
+
+/*
+ * Lifetime cumulative metrics over the resampled history, without materializing it:
+ * pass 1 streams the grid into the center sums and the stress / reward integrals (dt = step),
+ * pass 2 streams it again for the mean distance to the center.
+ * Time complexity: O(n + grid points) = T + T
+ * Space complexity: O(1)
+ */
+CumulativeMetrics calculate_resampled_cumulative(const HistorySpan& history, const Interval_Params& params,
+                                                 const resample_option& option);
@@ -0,0 +1,179 @@
+#include "EGO_series.hpp"
+#include "EGO_kernel.hpp"
+#include "EGO_model.hpp"
+#include "EGO_fastmath.hpp"
+#include "EGO_parallel.hpp"
+#include <cmath>
+#include <type_traits>
+
+namespace
+{
+    // samples per work item: big enough to amortize scheduling, small enough to balance
+    const std::size_t SERIES_CHUNK = 8192;
+
+    struct Series_Params
+    {
+        Interval_Params interval;
+        double weight_k;
+        double theta_0;
+    };
+
+    /*
+     * Instant metrics of samples [begin, end): stress, reward, ratios, deviation.
+     * Same math as get_instant_terms / get_stress_reward_ratio,
+     * written without branches (clamp01, selects) so the loop vectorizes.
+     * Time complexity: O(end - begin)
+     */
+    template <typename Stride, typename Model>
+    void instant_chunk(const HistorySpan& history, Stride stride, std::size_t begin, std::size_t end,
+                       const Interval_Params& p, const Model& model, MetricSeries& out)
+    {
+        const double* hv = history.v;
+        const double* ha = history.a;
+        const double* hd = history.d;
+
+        double* stress_out = out.instant_stress.data();
+        double* reward_out = out.instant_reward.data();
+        double* total_out = out.instant_ratio_total.data();
+        double* stress_ratio_out = out.instant_stress_ratio.data();
+        double* reward_ratio_out = out.instant_reward_ratio.data();
+        double* deviation_out = out.deviation.data();
+
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const double V = hv[i * stride];
+            const double A = ha[i * stride];
+            const double D = hd[i * stride];
+
+            const double bv = V - p.baseline_v;
+            const double ba = A - p.baseline_a;
+            const double bd = D - p.baseline_d;
+            const double distance_pow2 = bv*bv + ba*ba + bd*bd;
+            const double damp = (distance_pow2 <= p.radius_pow2) ? p.dampening_factor : 1.0;
+
+            const double stress = model.stress(V, A) * damp;
+            const double reward = model.reward(V, A);
+            const double total = stress + reward;
+            const double safe_total = (total > 1e-9) ? total : 1.0;
+
+            stress_out[i] = stress;
+            reward_out[i] = reward;
+            total_out[i] = total;
+            stress_ratio_out[i] = (total > 1e-9) ? stress / safe_total : 0.0;
+            reward_ratio_out[i] = (total > 1e-9) ? reward / safe_total : 0.0;
+            deviation_out[i] = std::sqrt(distance_pow2);
+        }
+    }
+
+    /*
+     * Dynamic metrics of samples [begin, end): delta to the previous sample and lability.
+     * Same math as calculate_delta / calculate_affective_lability; with Precision == fast
+     * atan2 / exp are inline polynomials, so this loop vectorizes too.
+     * Time complexity: O(end - begin)
+     */
+    template <math_precision Precision, typename Stride>
+    void dynamics_chunk(const HistorySpan& history, Stride stride, std::size_t begin, std::size_t end,
+                        const Series_Params& p, MetricSeries& out)
+    {
+        const double* hv = history.v;
+        const double* ha = history.a;
+        const double* hd = history.d;
+        const double* ht = history.timestamp;
+
+        double* dv_out = out.delta_v.data();
+        double* da_out = out.delta_a.data();
+        double* dd_out = out.delta_d.data();
+        double* lability_out = out.affective_lability.data();
+        // locals, so the stores below can't alias them
+        const double weight_k = p.weight_k;
+        const double theta_0 = p.theta_0;
+
+        // row 0 has no prev: delta 0 (kept out of the loop so the loop has no branch)
+        std::size_t i = begin;
+        if (begin == 0 && end > 0)
+        {
+            dv_out[0] = da_out[0] = dd_out[0] = 0.0;
+            lability_out[0] = math_sigmoid<Precision>(weight_k * (math_atan2<Precision>(0.0, 0.0) - theta_0));
+            i = 1;
+        }
+
+        // deltas first, then lability from the delta columns: two loops with few
+        // pointers each, so the compiler's alias checks stay cheap and both vectorize
+        for (std::size_t j = i; j < end; j++)
+        {
+            const double dt_raw = ht[j * stride] - ht[(j - 1) * stride];
+            const double dt = (dt_raw <= 0) ? 1.0 : dt_raw;
+            dv_out[j] = (hv[j * stride] - hv[(j - 1) * stride]) / dt;
+            da_out[j] = (ha[j * stride] - ha[(j - 1) * stride]) / dt;
+            dd_out[j] = (hd[j * stride] - hd[(j - 1) * stride]) / dt;
+        }
+        for (std::size_t j = i; j < end; j++)
+        {
+            const double theta = math_atan2<Precision>(dd_out[j], std::sqrt(dv_out[j]*dv_out[j] + da_out[j]*da_out[j]));
+            lability_out[j] = math_sigmoid<Precision>(weight_k * (theta - theta_0));
+        }
+    }
+
+    template <math_precision Precision, typename Stride, typename Model>
+    void series_chunk(const HistorySpan& history, Stride stride, std::size_t begin, std::size_t end,
+                      const Series_Params& p, const Model& model, MetricSeries& out)
+    {
+        instant_chunk(history, stride, begin, end, p.interval, model, out);
+        dynamics_chunk<Precision>(history, stride, begin, end, p, out);
+    }
+}
+
+void MetricSeries::resize(std::size_t n)
+{
+    for (auto* column : {&instant_stress, &instant_reward, &instant_ratio_total,
+                         &instant_stress_ratio, &instant_reward_ratio, &deviation,
+                         &delta_v, &delta_a, &delta_d, &affective_lability})
+    {
+        column->resize(n);
+    }
+}
+
+/*
+ * This function returns the instant/dynamic metrics of every sample in one pass,
+ * instead of n calls to EGO_compute on growing prefixes (O(n^2)).
+ * Chunks of SERIES_CHUNK samples are spread over parallel_for workers.
+ * Time complexity: O(n / threads)
+ * Space complexity: O(n) (the output)
+ */
+MetricSeries EGO_compute_series(const HistorySpan& history,
+                                const std::optional<EGO_axis>& emotion_base,
+                                const std::optional<variable>& variables,
+                                const std::optional<weight>& weights,
+                                unsigned int threads,
+                                math_precision precision)
+{
+    EGO_axis base = emotion_base.value_or(EGO_axis{});
+    weight w = weights.value_or(weight{});
+    variable v = variables.value_or(variable{});
+    const Series_Params params{make_interval_params(base, w, v), w.weight_k, v.theta_0};
+
+    MetricSeries out;
+    out.resize(history.size);
+
+    const std::size_t chunks = (history.size + SERIES_CHUNK - 1) / SERIES_CHUNK;
+    with_stress_model(params.interval, [&](const auto& model)
+    {
+        with_math_precision(precision, [&](auto mode)
+        {
+            constexpr math_precision Precision = decltype(mode)::value;
+            parallel_for(chunks, threads, [&](std::size_t c)
+            {
+                const std::size_t begin = c * SERIES_CHUNK;
+                const std::size_t end = std::min(history.size, begin + SERIES_CHUNK);
+
+                // unit stride as a constant so the compiler can vectorize
+                if (history.stride == 1)
+                    series_chunk<Precision>(history, std::integral_constant<std::size_t, 1>{}, begin, end, params, model, out);
+                else
+                    series_chunk<Precision>(history, history.stride, begin, end, params, model, out);
+            }, 1);
+        });
+    });
+
+    return out;
+}
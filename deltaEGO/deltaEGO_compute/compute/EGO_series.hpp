@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <vector>
+#include "EGO_compute.hpp"
+
+// return struct------------------------------------------------------------
+/*
+ * Per-sample InstantMetrics + DynamicMetrics of a whole history.
+ * Row i is what EGO_compute reports when sample i is `current` and sample i-1 is `prev`
+ * (row 0 has no prev: delta 0), i.e. the dashboard view of every turn.
+ */
+struct MetricSeries
+{
+    // InstantMetrics
+    std::vector<double> instant_stress;
+    std::vector<double> instant_reward;
+    std::vector<double> instant_ratio_total;
+    std::vector<double> instant_stress_ratio;
+    std::vector<double> instant_reward_ratio;
+    std::vector<double> deviation;
+
+    // DynamicMetrics
+    std::vector<double> delta_v;
+    std::vector<double> delta_a;
+    std::vector<double> delta_d;
+    std::vector<double> affective_lability;
+
+    void resize(std::size_t n);
+    std::size_t size() const { return instant_stress.size(); }
+};
+// return struct------------------------------------------------------------
+
+// main --------------------------------------------------------------------
+// one O(n) pass, chunked across threads for long histories (threads == 0 -> every hardware thread)
+// precision == fast uses the branch-free exp / atan2 of EGO_fastmath.hpp for the lability column
+MetricSeries EGO_compute_series(const HistorySpan& history,
+                                const std::optional<EGO_axis>& emotion_base,
+                                const std::optional<variable>& variables,
+                                const std::optional<weight>& weights,
+                                unsigned int threads = 0,
+                                math_precision precision = math_precision::exact);
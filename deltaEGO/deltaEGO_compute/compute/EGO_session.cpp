@@ -0,0 +1,264 @@
+#include "EGO_session.hpp"
+#include <stdexcept>
+#include <string>
+#include "EGO_parallel.hpp"
+
+namespace
+{
+    // splitmix64 finalizer: sequential ids spread over every shard
+    inline std::uint64_t mix_id(std::uint64_t x)
+    {
+        x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    std::size_t round_up_pow2(std::size_t n)
+    {
+        std::size_t p = 1;
+        while (p < n)
+            p <<= 1;
+        return p;
+    }
+}
+
+SessionManager::SessionManager(std::size_t shard_count)
+{
+    if (shard_count == 0)
+        throw std::invalid_argument("shard_count must be positive");
+
+    const std::size_t n = round_up_pow2(shard_count);
+    this->shards = std::make_unique<Shard[]>(n);
+    this->shard_mask = n - 1;
+}
+
+SessionManager::Shard& SessionManager::shard_of(character_id id) const
+{
+    return this->shards[mix_id(id) & this->shard_mask];
+}
+
+SessionManager::Character& SessionManager::find(Shard& shard, character_id id)
+{
+    auto it = shard.table.find(id);
+    if (it == shard.table.end())
+        throw std::invalid_argument("unknown character id " + std::to_string(id));
+    return it->second;
+}
+
+// table -------------------------------------------------------------------------
+bool SessionManager::create(character_id id, const CharacterSettings& settings)
+{
+    Shard& shard = this->shard_of(id);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.table.try_emplace(id, Character{settings, {}, std::nullopt}).second;
+}
+
+bool SessionManager::remove(character_id id)
+{
+    Shard& shard = this->shard_of(id);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.table.erase(id) > 0;
+}
+
+bool SessionManager::contains(character_id id) const
+{
+    Shard& shard = this->shard_of(id);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.table.count(id) > 0;
+}
+
+std::size_t SessionManager::size() const
+{
+    std::size_t total = 0;
+    for (std::size_t s = 0; s <= this->shard_mask; s++)
+    {
+        std::lock_guard<std::mutex> guard(this->shards[s].lock);
+        total += this->shards[s].table.size();
+    }
+    return total;
+}
+
+// per character -------------------------------------------------------------------
+CharacterSettings SessionManager::get_settings(character_id id) const
+{
+    Shard& shard = this->shard_of(id);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return find(shard, id).settings;
+}
+
+void SessionManager::set_settings(character_id id, const CharacterSettings& settings)
+{
+    Shard& shard = this->shard_of(id);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    Character& character = find(shard, id);
+    character.settings = settings;
+
+    // an adaptive baseline keeps what it learned, only its time constant changes
+    if (settings.baseline_time_constant <= 0)
+        character.adaptive.reset();
+    else if (character.adaptive)
+        character.adaptive->set_time_constant(settings.baseline_time_constant);
+}
+
+/*
+ * Copies the history out (owner is left empty).
+ * Time complexity: O(n)
+ */
+VADHistory SessionManager::history(character_id id) const
+{
+    Shard& shard = this->shard_of(id);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    const Character& character = find(shard, id);
+
+    VADHistory out;
+    out.reserve(character.history.size());
+    const std::uint32_t owner_id = out.intern_owner("");
+    for (const Sample& s : character.history)
+        out.push_back(s.v, s.a, s.d, s.timestamp, owner_id);
+    return out;
+}
+
+std::size_t SessionManager::history_size(character_id id) const
+{
+    Shard& shard = this->shard_of(id);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return find(shard, id).history.size();
+}
+
+void SessionManager::clear_history(character_id id)
+{
+    Shard& shard = this->shard_of(id);
+    std::lock_guard<std::mutex> guard(shard.lock);
+
+    // release the buffer too: a cleared character should cost what an idle one does
+    Character& character = find(shard, id);
+    std::vector<Sample>().swap(character.history);
+    character.adaptive.reset();
+}
+
+// push ----------------------------------------------------------------------------
+/*
+ * Same as analize_VAD on the Python side: the new sample is `current`,
+ * the sample before it is `prev`, and the history includes the new sample.
+ * With an adaptive baseline, the new sample updates it before the analysis.
+ * Time complexity: O(n)
+ */
+AnalysisResult SessionManager::push_locked(Character& character, double V, double A, double D, double timestamp)
+{
+    std::vector<Sample>& history = character.history;
+    history.push_back(Sample{V, A, D, timestamp});
+
+    const std::size_t n = history.size();
+    const Sample* base = history.data();
+    const HistorySpan span{&base->v, &base->a, &base->d, &base->timestamp, n, sizeof(Sample) / sizeof(double)};
+
+    std::optional<VADPoint> prev;
+    if (n > 1)
+        prev = span.point(n - 2);
+
+    const CharacterSettings& settings = character.settings;
+    EGO_axis axis = settings.emotion_base;
+    if (settings.baseline_time_constant > 0)
+    {
+        if (!character.adaptive)
+            character.adaptive.emplace(settings.baseline_time_constant, settings.emotion_base.baseline);
+        character.adaptive->push(V, A, D, timestamp);
+        axis = character.adaptive->apply(settings.emotion_base);
+    }
+
+    // the caller may already be one of many workers, so no extra threads here
+    return EGO_compute_sync(span.point(n - 1), span, prev, axis, settings.variables, settings.weights);
+}
+
+AnalysisResult SessionManager::push(character_id id, double V, double A, double D, double timestamp)
+{
+    Shard& shard = this->shard_of(id);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    Character& character = shard.table[id];
+    AnalysisResult result = push_locked(character, V, A, D, timestamp);
+
+    if (this->detector)
+        this->detector->observe(id, timestamp, result, character.settings.emotion_base.stabilityRadius);
+    return result;
+}
+
+/*
+ * Buckets the inputs by shard (stable, so per-id order is kept),
+ * then each worker takes a whole shard and locks it once.
+ * Time complexity: O(total history of the pushed characters / threads)
+ * Space complexity: O(count)
+ */
+std::vector<AnalysisResult> SessionManager::push_batch(const std::vector<character_id>& ids,
+                                                       const std::vector<double>& V,
+                                                       const std::vector<double>& A,
+                                                       const std::vector<double>& D,
+                                                       const std::vector<double>& timestamp,
+                                                       unsigned int threads)
+{
+    const std::size_t count = ids.size();
+    if (V.size() != count || A.size() != count || D.size() != count || timestamp.size() != count)
+        throw std::invalid_argument("ids, V, A, D and timestamp must have the same length");
+
+    const std::size_t shard_count = this->shard_mask + 1;
+
+    // counting sort of input indices by shard
+    std::vector<std::size_t> shard_of_input(count);
+    std::vector<std::size_t> bucket_start(shard_count + 1, 0);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        shard_of_input[i] = mix_id(ids[i]) & this->shard_mask;
+        bucket_start[shard_of_input[i] + 1]++;
+    }
+    for (std::size_t s = 0; s < shard_count; s++)
+        bucket_start[s + 1] += bucket_start[s];
+
+    std::vector<std::size_t> order(count);
+    {
+        std::vector<std::size_t> fill(bucket_start.begin(), bucket_start.end() - 1);
+        for (std::size_t i = 0; i < count; i++)
+            order[fill[shard_of_input[i]]++] = i;
+    }
+
+    std::vector<AnalysisResult> results(count);
+    parallel_for(shard_count, threads, [&](std::size_t s)
+    {
+        const std::size_t begin = bucket_start[s], end = bucket_start[s + 1];
+        if (begin == end)
+            return;
+
+        Shard& shard = this->shards[s];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        for (std::size_t k = begin; k < end; k++)
+        {
+            const std::size_t i = order[k];
+            Character& character = shard.table[ids[i]];
+            results[i] = push_locked(character, V[i], A[i], D[i], timestamp[i]);
+
+            if (this->detector)
+                this->detector->observe(ids[i], timestamp[i], results[i], character.settings.emotion_base.stabilityRadius);
+        }
+    }, 1);
+
+    return results;
+}
+
+/*
+ * Table nodes are estimated as key + value + two pointers (next, cached hash).
+ * Time complexity: O(characters)
+ */
+std::size_t SessionManager::memory_usage() const
+{
+    constexpr std::size_t node_bytes = sizeof(character_id) + sizeof(Character) + 2 * sizeof(void*);
+
+    std::size_t total = 0;
+    for (std::size_t s = 0; s <= this->shard_mask; s++)
+    {
+        const Shard& shard = this->shards[s];
+        std::lock_guard<std::mutex> guard(shard.lock);
+
+        total += shard.table.bucket_count() * sizeof(void*);
+        for (const auto& entry : shard.table)
+            total += node_bytes + entry.second.history.capacity() * sizeof(Sample);
+    }
+    return total;
+}
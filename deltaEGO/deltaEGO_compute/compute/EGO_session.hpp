@@ -0,0 +1,105 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "EGO_compute.hpp"
+#include "VAD_history.hpp"
+#include "EGO_events.hpp"
+#include "EGO_baseline.hpp"
+
+using character_id = std::uint64_t;
+
+// input struct-------------------------------------------------------------
+// per-character constants (what deltaEGO keeps as emotion_base / weights / variables dicts)
+struct CharacterSettings
+{
+    EGO_axis emotion_base;
+    variable variables;
+    weight weights;
+    double baseline_time_constant = 0.0;    // > 0: baseline follows an EWMA of the character's samples
+};
+// input struct-------------------------------------------------------------
+
+/*
+ * Every character's state in one native object; Python only holds the id.
+ *  - characters live in `shard_count` hash tables, each behind its own mutex,
+ *    so pushes to characters in different shards run in parallel,
+ *  - history is one array of 32-byte samples (read through a stride-4 HistorySpan),
+ *    the last sample doubles as `prev`, no owner strings are stored,
+ *  - an idle character is its settings + an empty vector + the table node (~200 bytes).
+ * The shard lock is held while a character is analyzed, so a long history only
+ * delays characters that hash to the same shard.
+ */
+class SessionManager
+{
+    public:
+    explicit SessionManager(std::size_t shard_count = 64);
+
+    // returns false if the id already exists (settings are left alone)
+    bool create(character_id id, const CharacterSettings& settings = CharacterSettings{});
+    bool remove(character_id id);
+    bool contains(character_id id) const;
+    std::size_t size() const;
+    std::size_t shard_count() const { return this->shard_mask + 1; }
+
+    // throw std::invalid_argument for an unknown id
+    CharacterSettings get_settings(character_id id) const;
+    void set_settings(character_id id, const CharacterSettings& settings);
+    VADHistory history(character_id id) const;
+    std::size_t history_size(character_id id) const;
+    void clear_history(character_id id);
+
+    // appends one sample and analyzes the character (unknown ids are created with default settings)
+    // Time complexity: O(n) of that character's history
+    AnalysisResult push(character_id id, double V, double A, double D, double timestamp);
+
+    /*
+     * push() for many characters at once, one worker per shard.
+     * Samples of the same id are applied in input order; results come back in input order.
+     */
+    std::vector<AnalysisResult> push_batch(const std::vector<character_id>& ids,
+                                           const std::vector<double>& V,
+                                           const std::vector<double>& A,
+                                           const std::vector<double>& D,
+                                           const std::vector<double>& timestamp,
+                                           unsigned int threads = 0);
+
+    // approximate heap bytes held by all characters
+    std::size_t memory_usage() const;
+
+    // every push result is also fed to this detector (stream = character id); set before pushing
+    void set_detector(std::shared_ptr<EventDetector> detector) { this->detector = std::move(detector); }
+    const std::shared_ptr<EventDetector>& get_detector() const { return this->detector; }
+
+    private:
+    struct Sample
+    {
+        double v, a, d, timestamp;
+    };
+
+    struct Character
+    {
+        CharacterSettings settings;
+        std::vector<Sample> history;
+        std::optional<AdaptiveBaseline> adaptive;   // only while baseline_time_constant > 0
+    };
+
+    // alignas: two shard mutexes never share a cache line
+    struct alignas(64) Shard
+    {
+        mutable std::mutex lock;
+        std::unordered_map<character_id, Character> table;
+    };
+
+    Shard& shard_of(character_id id) const;
+    static Character& find(Shard& shard, character_id id);
+    static AnalysisResult push_locked(Character& character, double V, double A, double D, double timestamp);
+
+    std::unique_ptr<Shard[]> shards;
+    std::size_t shard_mask;
+    std::shared_ptr<EventDetector> detector;
+};
@@ -0,0 +1,180 @@
+#include "EGO_sweep.hpp"
+#include "EGO_kernel.hpp"
+#include "EGO_parallel.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /*
+     * Per-sample terms of the history that are the same for every configuration.
+     * Interval i (i >= 1) is stored at index i - 1.
+     */
+    struct Shared_Columns
+    {
+        std::vector<double> stress_v;  // (1 - V) / 2
+        std::vector<double> reward_v;  // (V + 1) / 2
+        std::vector<double> arousal;   // A
+        std::vector<double> dt;        // interval length (non-positive -> 0.1)
+        std::vector<double> inside;    // 1 if |x - baseline| <= stabilityRadius, else 0 (double so the loop stays one width)
+    };
+
+    /*
+     * Time complexity: O(n)
+     * Space complexity: O(n)
+     */
+    Shared_Columns make_shared_columns(const HistorySpan& history, const EGO_axis& base)
+    {
+        Shared_Columns cols;
+        const std::size_t intervals = (history.size > 1) ? history.size - 1 : 0;
+        cols.stress_v.resize(intervals);
+        cols.reward_v.resize(intervals);
+        cols.arousal.resize(intervals);
+        cols.dt.resize(intervals);
+        cols.inside.resize(intervals);
+
+        const double radius_pow2 = (base.stabilityRadius >= 0.0) ? base.stabilityRadius * base.stabilityRadius : -1.0;
+        for (std::size_t j = 0; j < intervals; j++)
+        {
+            const std::size_t i = j + 1;
+            const double V = history.v_at(i);
+            const double A = history.a_at(i);
+            const double bv = V - base.baseline.v;
+            const double ba = A - base.baseline.a;
+            const double bd = history.d_at(i) - base.baseline.d;
+            const double dt_raw = history.timestamp_at(i) - history.timestamp_at(i - 1);
+
+            cols.stress_v[j] = (1.0 - V) / 2.0;
+            cols.reward_v[j] = (V + 1.0) / 2.0;
+            cols.arousal[j] = A;
+            cols.dt[j] = (dt_raw <= 0) ? 0.1 : dt_raw;
+            cols.inside[j] = (bv*bv + ba*ba + bd*bd <= radius_pow2) ? 1.0 : 0.0;
+        }
+        return cols;
+    }
+
+    // stress * dt and reward * dt of shared interval j under weights w (kept small so it inlines)
+    inline void add_sweep_term(const Shared_Columns& cols, std::size_t j, const weight& w, double damp,
+                               double& stress, double& reward)
+    {
+        const double s = clamp01(w.weightV_stress * cols.stress_v[j] + w.weightA_stress * cols.arousal[j]);
+        const double r = clamp01(w.weightV_reward * cols.reward_v[j] + w.weightA_reward * cols.arousal[j]);
+        stress += s * ((cols.inside[j] != 0.0) ? damp : 1.0) * cols.dt[j];
+        reward += r * cols.dt[j];
+    }
+
+    // configurations per work item, and samples per tile (5 columns * 1024 * 8 bytes stay in L2)
+    const std::size_t SWEEP_GROUP = 8;
+    const std::size_t SWEEP_TILE = 1024;
+
+    /*
+     * Cumulative stress / reward of configurations params[first, last) over the shared columns.
+     * The history is walked in tiles and every configuration of the group runs over a tile
+     * while it is still in cache, so the columns are read from memory once per group.
+     * Four partial sums per configuration (like the fused kernel) so the adds don't serialize.
+     * Time complexity: O(n * (last - first))
+     * Space complexity: O(1)
+     */
+    void sweep_integrals(const Shared_Columns& cols, const std::vector<sweep_param>& params,
+                         std::size_t first, std::size_t last, double* stress_out, double* reward_out)
+    {
+        const std::size_t n = cols.dt.size();
+        const std::size_t group = last - first;
+
+        double lane_stress[SWEEP_GROUP][4] = {};
+        double lane_reward[SWEEP_GROUP][4] = {};
+
+        for (std::size_t tile = 0; tile < n; tile += SWEEP_TILE)
+        {
+            const std::size_t tile_end = std::min(n, tile + SWEEP_TILE);
+
+            for (std::size_t g = 0; g < group; g++)
+            {
+                const weight w = params[first + g].weights;
+                const double damp = params[first + g].variables.dampening_factor;
+                double* ls = lane_stress[g];
+                double* lr = lane_reward[g];
+
+                std::size_t j = tile;
+                for (; j + 4 <= tile_end; j += 4)
+                {
+                    add_sweep_term(cols, j,     w, damp, ls[0], lr[0]);
+                    add_sweep_term(cols, j + 1, w, damp, ls[1], lr[1]);
+                    add_sweep_term(cols, j + 2, w, damp, ls[2], lr[2]);
+                    add_sweep_term(cols, j + 3, w, damp, ls[3], lr[3]);
+                }
+                for (; j < tile_end; j++)
+                    add_sweep_term(cols, j, w, damp, ls[0], lr[0]);
+            }
+        }
+
+        for (std::size_t g = 0; g < group; g++)
+        {
+            stress_out[g] = (lane_stress[g][0] + lane_stress[g][1]) + (lane_stress[g][2] + lane_stress[g][3]);
+            reward_out[g] = (lane_reward[g][0] + lane_reward[g][1]) + (lane_reward[g][2] + lane_reward[g][3]);
+        }
+    }
+}
+
+std::vector<sweep_param> make_sweep_grid(const std::vector<weight>& weights, const std::vector<variable>& variables)
+{
+    std::vector<sweep_param> grid;
+    grid.reserve(weights.size() * variables.size());
+
+    for (const weight& w : weights)
+    {
+        for (const variable& v : variables)
+            grid.push_back(sweep_param{w, v});
+    }
+    return grid;
+}
+
+/*
+ * This function analyzes one history under many parameter sets.
+ * Time complexity: O(n + params * (n / threads))
+ * Space complexity: O(n + params)
+ */
+AnalysisColumns EGO_compute_sweep(const VADPoint& current,
+                                  const HistorySpan& history,
+                                  const std::optional<VADPoint>& prev,
+                                  const std::optional<EGO_axis>& emotion_base,
+                                  const std::vector<sweep_param>& params,
+                                  unsigned int threads,
+                                  math_precision precision)
+{
+    const EGO_axis base = emotion_base.value_or(EGO_axis{});
+
+    AnalysisColumns out;
+    out.resize(params.size());
+    if (params.empty())
+        return out;
+
+    // shared by every configuration
+    const Shared_Columns cols = make_shared_columns(history, base);
+    const VAD_ave average = calculate_average(history);
+    const Instant_Shared instant = calculate_instant_shared(current, prev, base.baseline, precision);
+
+    const std::size_t groups = (params.size() + SWEEP_GROUP - 1) / SWEEP_GROUP;
+    parallel_for(groups, threads, [&](std::size_t group)
+    {
+        const std::size_t first = group * SWEEP_GROUP;
+        const std::size_t last = std::min(params.size(), first + SWEEP_GROUP);
+
+        double stress[SWEEP_GROUP], reward[SWEEP_GROUP];
+        sweep_integrals(cols, params, first, last, stress, reward);
+
+        for (std::size_t k = first; k < last; k++)
+        {
+            const sweep_param& p = params[k];
+
+            // only the weight-dependent O(1) terms (clamps, lability sigmoid) per configuration
+            AnalysisResult result;
+            fill_instant_metrics(result, instant, current, base.stabilityRadius, p.weights, p.variables, precision);
+            result.cumulative = make_cumulative_metrics(average, stress[k - first], reward[k - first]);
+
+            out.set(k, result);
+        }
+    }, 1);
+
+    return out;
+}
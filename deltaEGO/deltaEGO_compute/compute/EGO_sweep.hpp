@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <vector>
+#include "EGO_compute.hpp"
+#include "EGO_batch.hpp"
+
+// input struct-------------------------------------------------------------
+// one configuration of a sweep
+struct sweep_param
+{
+    weight weights;
+    variable variables;
+};
+// input struct-------------------------------------------------------------
+
+// every (weights[i], variables[j]) pair, weights-major
+std::vector<sweep_param> make_sweep_grid(const std::vector<weight>& weights, const std::vector<variable>& variables);
+
+/*
+ * Runs EGO_compute for every parameter set over one history (same current / prev / emotion_base).
+ * Row k of the result is params[k].
+ * Work that doesn't depend on weights / variables is done once:
+ *  - per-sample valence/arousal terms, dt and the inside-stability-radius mask,
+ *  - the average center / radius,
+ *  - delta, its angle and the deviation (calculate_instant_shared).
+ * Each configuration then costs one multiply-add pass over the shared columns,
+ * plus the O(1) clamps and lability sigmoid of its weights (fill_instant_metrics).
+ * precision == fast uses the branch-free atan2 / exp of EGO_fastmath.hpp for the lability column.
+ */
+AnalysisColumns EGO_compute_sweep(const VADPoint& current,
+                                  const HistorySpan& history,
+                                  const std::optional<VADPoint>& prev,
+                                  const std::optional<EGO_axis>& emotion_base,
+                                  const std::vector<sweep_param>& params,
+                                  unsigned int threads = 0,
+                                  math_precision precision = math_precision::exact);
@@ -0,0 +1,132 @@
+#include "EGO_tracker.hpp"
+#include <stdexcept>
+
+std::shared_ptr<KDTree> load_emotion_tree(const std::string& json_path)
+{
+    auto tree = std::make_shared<KDTree>();
+    if (!tree->load_data(json_path))
+        throw std::runtime_error("failed to load VAD data from '" + json_path + "'");
+    return tree;
+}
+
+EGOTracker::EGOTracker(std::shared_ptr<KDTree> tree,
+                       const std::string& owner,
+                       const std::optional<EGO_axis>& emotion_base,
+                       const std::optional<variable>& variables,
+                       const std::optional<weight>& weights,
+                       const search_option& search)
+    : tree(std::move(tree)), search_opt(search)
+{
+    if (!this->tree)
+        throw std::invalid_argument("EGOTracker needs an emotion tree");
+
+    this->bundle.emotion_base = emotion_base;
+    this->bundle.variables = variables;
+    this->bundle.weights = weights;
+    this->owner_id = this->bundle.history.intern_owner(owner);
+}
+
+/*
+ * [filter] -> search -> append -> analyze, same order as VADsearch + analize_VAD:
+ * the new point is `current`, the one before is `prev`, history includes the new point.
+ * Runs on the caller's thread (EGO_compute_sync), like SessionManager: no threads spawned per step.
+ * Time complexity: O(log m + n)
+ */
+TrackerResult EGOTracker::step(double V, double A, double D, double timestamp)
+{
+    TrackerResult result;
+
+    // smooth first, so search labels and history deltas both see the filtered point
+    if (this->smoothing)
+    {
+        const VADPoint smoothed = this->smoothing->filter(V, A, D, timestamp);
+        V = smoothed.v;
+        A = smoothed.a;
+        D = smoothed.d;
+    }
+
+    // search
+    const std::vector<SearchHit> hits = this->tree->VAD_search_hits(
+        V, A, D, this->search_opt.k, this->search_opt.d, this->search_opt.SIGMA, this->search_opt.opt);
+
+    result.hits.reserve(hits.size());
+    for (const SearchHit& hit : hits)
+        result.hits.push_back(TrackerHit{(hit.idx == NEUTRAL_IDX) ? std::string("neutral") : this->tree->Emotions[hit.idx].term,
+                                         hit.distance_pow2, hit.similarity_percent});
+
+    // append
+    VADHistory& history = this->bundle.history;
+    history.push_back(V, A, D, timestamp, this->owner_id);
+
+    const std::size_t n = history.size();
+    this->bundle.current = VADPoint{V, A, D, timestamp, history.owner_name(this->owner_id)};
+    if (n > 1)
+        this->bundle.prev = VADPoint{history.v[n - 2], history.a[n - 2], history.d[n - 2], history.timestamp[n - 2],
+                                     this->bundle.current.owner};
+    else
+        this->bundle.prev.reset();
+
+    // analyze (an adaptive baseline takes the new sample first, then stands in for the static one)
+    if (this->adaptive)
+    {
+        this->adaptive->push(V, A, D, timestamp);
+
+        const std::optional<EGO_axis> configured = this->bundle.emotion_base;
+        this->bundle.emotion_base = this->adaptive->apply(configured.value_or(EGO_axis{}));
+        result.analysis = EGO_compute_sync(this->bundle);
+        this->bundle.emotion_base = configured;
+    }
+    else
+    {
+        result.analysis = EGO_compute_sync(this->bundle);
+    }
+
+    if (this->detector)
+        this->detector->observe(this->stream, timestamp, result.analysis,
+                                this->bundle.emotion_base.value_or(EGO_axis{}).stabilityRadius);
+    return result;
+}
+
+void EGOTracker::set_adaptive_baseline(double time_constant)
+{
+    if (time_constant <= 0)
+        this->adaptive.reset();
+    else if (this->adaptive)
+        this->adaptive->set_time_constant(time_constant);
+    else
+        this->adaptive.emplace(time_constant, this->bundle.emotion_base.value_or(EGO_axis{}).baseline);
+}
+
+std::optional<VADPoint> EGOTracker::baseline() const
+{
+    if (!this->adaptive)
+        return std::nullopt;
+    return this->adaptive->value();
+}
+
+void EGOTracker::set_filter(const std::optional<filter_option>& option)
+{
+    if (option)
+        this->smoothing.emplace(*option);
+    else
+        this->smoothing.reset();
+}
+
+void EGOTracker::set_detector(std::shared_ptr<EventDetector> detector, std::uint64_t stream)
+{
+    this->detector = std::move(detector);
+    this->stream = stream;
+}
+
+void EGOTracker::clear()
+{
+    const std::string owner = this->bundle.history.owner_name(this->owner_id);
+    this->bundle.history.clear();
+    this->bundle.prev.reset();
+    this->owner_id = this->bundle.history.intern_owner(owner);
+
+    if (this->adaptive)
+        this->adaptive->reset(this->bundle.emotion_base.value_or(EGO_axis{}).baseline);
+    if (this->smoothing)
+        this->smoothing->reset();
+}
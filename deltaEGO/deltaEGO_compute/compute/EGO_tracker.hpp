@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "EGO_compute.hpp"
+#include "VAD_history.hpp"
+#include "EGO_events.hpp"
+#include "EGO_baseline.hpp"
+#include "EGO_filter.hpp"
+#include "VAD_customVDB.hpp"   // KDTree, from deltaEGO_VDB
+
+// return struct------------------------------------------------------------
+struct TrackerHit
+{
+    std::string emotion;
+    double distance_pow2;
+    int similarity_percent;
+};
+
+// everything one turn produces: nearest emotions + the analysis of the updated history
+struct TrackerResult
+{
+    std::vector<TrackerHit> hits;   // nearest first
+    AnalysisResult analysis;
+};
+// return struct------------------------------------------------------------
+
+// input struct-------------------------------------------------------------
+struct search_option
+{
+    int k = 5;
+    double d = 1.0;
+    double SIGMA = 0.5;
+    std::string opt = "knn~l2 -S";
+};
+// input struct-------------------------------------------------------------
+
+/*
+ * One character's turn loop in one native call:
+ *  k-d tree search -> append to native history -> EGO_compute.
+ * Replaces VADsearch (JSON) + analize_VAD (dict -> compute_in) + analysis_cpp_to_py.
+ * The tree is shared (read-only) between trackers, so thousands of characters load it once.
+ */
+class EGOTracker
+{
+    public:
+    EGOTracker(std::shared_ptr<KDTree> tree,
+               const std::string& owner,
+               const std::optional<EGO_axis>& emotion_base = std::nullopt,
+               const std::optional<variable>& variables = std::nullopt,
+               const std::optional<weight>& weights = std::nullopt,
+               const search_option& search = search_option{});
+
+    // Time complexity: O(log m) search + O(n) analysis
+    TrackerResult step(double V, double A, double D, double timestamp);
+
+    const VADHistory& history() const { return bundle.history; }
+    compute_in& settings() { return bundle; }   // emotion_base / weights / variables / cumulative
+    search_option& search() { return search_opt; }
+    void clear();
+
+    // every step result is also fed to this detector under `stream`
+    void set_detector(std::shared_ptr<EventDetector> detector, std::uint64_t stream);
+
+    // > 0: emotion_base.baseline follows an EWMA of this tracker's samples, 0: static again
+    void set_adaptive_baseline(double time_constant);
+    std::optional<VADPoint> baseline() const;
+
+    // smooths V/A/D before both the search and the history (nullopt: raw values again)
+    void set_filter(const std::optional<filter_option>& option);
+
+    private:
+    std::shared_ptr<KDTree> tree;
+    search_option search_opt;
+
+    // reused every turn: history lives here, current / prev are overwritten
+    compute_in bundle;
+    std::uint32_t owner_id;
+
+    std::shared_ptr<EventDetector> detector;
+    std::uint64_t stream = 0;
+
+    std::optional<AdaptiveBaseline> adaptive;
+    std::optional<OneEuroFilter> smoothing;
+};
+
+// loads VAD.json into a tree that trackers can share
+std::shared_ptr<KDTree> load_emotion_tree(const std::string& json_path);
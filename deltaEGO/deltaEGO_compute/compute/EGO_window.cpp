@@ -0,0 +1,275 @@
+#include "EGO_window.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const VAD_ave EMPTY_AREA{0.0, 0.0, 0.0, 0.05};
+
+    // 2^(-dt / half_life); a non-positive half life keeps nothing from the past
+    inline double decay_factor(double dt, double half_life)
+    {
+        if (dt <= 0)
+            return 1.0;
+        if (half_life <= 0)
+            return 0.0;
+        return std::exp2(-dt / half_life);
+    }
+
+    inline double rms_radius(double sum_sq, double w, double cx, double cy, double cz)
+    {
+        return std::sqrt(std::max(0.0, sum_sq / w - (cx*cx + cy*cy + cz*cz)));
+    }
+}
+
+// batch ---------------------------------------------------------------------------
+/*
+ * This function returns cumulative metrics of the samples in the last window_seconds.
+ * Time complexity: O(window) (scans back from the newest sample)
+ * Space complexity: O(1)
+ */
+CumulativeMetrics calculate_window_cumulative(const HistorySpan& history, const Interval_Params& params, double window_seconds)
+{
+    const std::size_t n = history.size;
+    if (n == 0)
+        return make_cumulative_metrics(EMPTY_AREA, 0.0, 0.0);
+
+    // first sample still inside the window
+    const double oldest = history.timestamp_at(n - 1) - window_seconds;
+    std::size_t start = n - 1;
+    while (start > 0 && history.timestamp_at(start - 1) >= oldest)
+        start--;
+
+    double v = 0, a = 0, d = 0, stress = 0, reward = 0;
+    for (std::size_t i = start; i < n; i++)
+    {
+        v += history.v_at(i);
+        a += history.a_at(i);
+        d += history.d_at(i);
+
+        // interval that started before the window doesn't count
+        if (i > start)
+        {
+            Interval_Terms terms = get_sample_terms(history.v_at(i), history.a_at(i), history.d_at(i),
+                                                    history.timestamp_at(i) - history.timestamp_at(i - 1), params);
+            stress += terms.stress;
+            reward += terms.reward;
+        }
+    }
+
+    const double count = static_cast<double>(n - start);
+    v /= count; a /= count; d /= count;
+
+    double r = 0;
+    for (std::size_t i = start; i < n; i++)
+    {
+        const double dx = v - history.v_at(i);
+        const double dy = a - history.a_at(i);
+        const double dz = d - history.d_at(i);
+        r += std::sqrt(dx*dx + dy*dy + dz*dz);
+    }
+    r /= count;
+
+    return make_cumulative_metrics(VAD_ave{v, a, d, r}, stress, reward);
+}
+
+/*
+ * This function returns exponentially decayed cumulative metrics.
+ * Runs the same recurrence as DecayAccumulator, so both give identical numbers.
+ * Time complexity: O(n)
+ * Space complexity: O(1)
+ */
+CumulativeMetrics calculate_decay_cumulative(const HistorySpan& history, const Interval_Params& params, double half_life)
+{
+    const std::size_t n = history.size;
+    if (n == 0)
+        return make_cumulative_metrics(EMPTY_AREA, 0.0, 0.0);
+
+    double w = 0, v = 0, a = 0, d = 0, sq = 0, stress = 0, reward = 0;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const double V = history.v_at(i);
+        const double A = history.a_at(i);
+        const double D = history.d_at(i);
+
+        if (i > 0)
+        {
+            const double dt_raw = history.timestamp_at(i) - history.timestamp_at(i - 1);
+            const double f = decay_factor(dt_raw, half_life);
+            w *= f; v *= f; a *= f; d *= f; sq *= f; stress *= f; reward *= f;
+
+            Interval_Terms terms = get_sample_terms(V, A, D, dt_raw, params);
+            stress += terms.stress;
+            reward += terms.reward;
+        }
+
+        w += 1.0;
+        v += V; a += A; d += D;
+        sq += V*V + A*A + D*D;
+    }
+
+    const double cx = v / w, cy = a / w, cz = d / w;
+    return make_cumulative_metrics(VAD_ave{cx, cy, cz, rms_radius(sq, w, cx, cy, cz)}, stress, reward);
+}
+
+
+// WindowAccumulator ---------------------------------------------------------------
+WindowAccumulator::WindowAccumulator(double window_seconds, const EGO_axis& base, const weight& w, const variable& v)
+    : window_seconds(window_seconds), params(make_interval_params(base, w, v)), ring(16)
+{
+}
+
+void WindowAccumulator::grow()
+{
+    std::vector<Sample> bigger(ring.size() * 2);
+    for (std::size_t i = 0; i < count; i++)
+        bigger[i] = at(i);
+
+    ring.swap(bigger);
+    head = 0;
+}
+
+// recompute running sums from the buffer so add/subtract rounding can't drift
+void WindowAccumulator::refresh_sums()
+{
+    sum_v = sum_a = sum_d = sum_stress = sum_reward = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const Sample& s = at(i);
+        sum_v += s.v;
+        sum_a += s.a;
+        sum_d += s.d;
+        sum_stress += s.terms.stress;
+        sum_reward += s.terms.reward;
+    }
+    evicted_since_refresh = 0;
+}
+
+/*
+ * Adds one sample and evicts everything older than the window.
+ * Time complexity: amortized O(1)
+ */
+void WindowAccumulator::push(const VADPoint& point)
+{
+    Sample s{point.v, point.a, point.d, point.timestamp, Interval_Terms{0.0, 0.0}};
+    if (count > 0)
+    {
+        const Sample& last = at(count - 1);
+        s.terms = get_sample_terms(point.v, point.a, point.d, point.timestamp - last.timestamp, params);
+    }
+
+    if (count == ring.size())
+        grow();
+
+    ring[(head + count) % ring.size()] = s;
+    count++;
+
+    sum_v += s.v;
+    sum_a += s.a;
+    sum_d += s.d;
+    sum_stress += s.terms.stress;
+    sum_reward += s.terms.reward;
+
+    // evict
+    const double oldest = point.timestamp - window_seconds;
+    while (count > 1 && at(0).timestamp < oldest)
+    {
+        const Sample& old = at(0);
+        sum_v -= old.v;
+        sum_a -= old.a;
+        sum_d -= old.d;
+        sum_stress -= old.terms.stress;
+        sum_reward -= old.terms.reward;
+
+        head = (head + 1) % ring.size();
+        count--;
+        evicted_since_refresh++;
+    }
+
+    // amortized O(1): one O(window) refresh per `ring.size()` evictions
+    if (evicted_since_refresh >= ring.size())
+        refresh_sums();
+}
+
+/*
+ * Time complexity: O(1) integrals and center, O(window) radius
+ */
+CumulativeMetrics WindowAccumulator::metrics() const
+{
+    if (count == 0)
+        return make_cumulative_metrics(EMPTY_AREA, 0.0, 0.0);
+
+    const double n = static_cast<double>(count);
+    const double cx = sum_v / n, cy = sum_a / n, cz = sum_d / n;
+
+    double r = 0;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const Sample& s = at(i);
+        const double dx = cx - s.v, dy = cy - s.a, dz = cz - s.d;
+        r += std::sqrt(dx*dx + dy*dy + dz*dz);
+    }
+    r /= n;
+
+    // the oldest sample's interval started before the window
+    const Interval_Terms& front = at(0).terms;
+    return make_cumulative_metrics(VAD_ave{cx, cy, cz, r}, sum_stress - front.stress, sum_reward - front.reward);
+}
+
+void WindowAccumulator::clear()
+{
+    head = count = evicted_since_refresh = 0;
+    sum_v = sum_a = sum_d = sum_stress = sum_reward = 0;
+}
+
+
+// DecayAccumulator ----------------------------------------------------------------
+DecayAccumulator::DecayAccumulator(double half_life, const EGO_axis& base, const weight& w, const variable& v)
+    : half_life(half_life), params(make_interval_params(base, w, v))
+{
+}
+
+/*
+ * Time complexity: O(1)
+ */
+void DecayAccumulator::push(const VADPoint& point)
+{
+    if (has_last)
+    {
+        const double dt_raw = point.timestamp - last_timestamp;
+        const double f = decay_factor(dt_raw, half_life);
+        weight_sum *= f; sum_v *= f; sum_a *= f; sum_d *= f; sum_sq *= f; stress *= f; reward *= f;
+
+        Interval_Terms terms = get_sample_terms(point.v, point.a, point.d, dt_raw, params);
+        stress += terms.stress;
+        reward += terms.reward;
+    }
+
+    weight_sum += 1.0;
+    sum_v += point.v;
+    sum_a += point.a;
+    sum_d += point.d;
+    sum_sq += point.v*point.v + point.a*point.a + point.d*point.d;
+
+    last_timestamp = point.timestamp;
+    has_last = true;
+}
+
+/*
+ * Time complexity: O(1)
+ */
+CumulativeMetrics DecayAccumulator::metrics() const
+{
+    if (!has_last)
+        return make_cumulative_metrics(EMPTY_AREA, 0.0, 0.0);
+
+    const double cx = sum_v / weight_sum, cy = sum_a / weight_sum, cz = sum_d / weight_sum;
+    return make_cumulative_metrics(VAD_ave{cx, cy, cz, rms_radius(sum_sq, weight_sum, cx, cy, cz)}, stress, reward);
+}
+
+void DecayAccumulator::clear()
+{
+    has_last = false;
+    last_timestamp = 0;
+    weight_sum = sum_v = sum_a = sum_d = sum_sq = stress = reward = 0;
+}
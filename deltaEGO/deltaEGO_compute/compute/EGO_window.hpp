@@ -0,0 +1,90 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "EGO_compute.hpp"
+#include "EGO_kernel.hpp"
+
+/*
+ * Cumulative metrics that forget old turns.
+ *  - window: only samples in [t_last - window_seconds, t_last] count.
+ *  - decay:  every interval counts, weighted by 2^(-(t_last - t) / half_life).
+ * Both return the usual CumulativeMetrics shape. In decay mode the radius is the
+ * decayed RMS distance to the decayed center (mean distance has no O(1) recurrence).
+ * Timestamps are expected to be non-decreasing (same as the rest of the module).
+ */
+
+// batch: over a whole history ------------------------------------------------------
+CumulativeMetrics calculate_window_cumulative(const HistorySpan& history, const Interval_Params& params, double window_seconds);
+CumulativeMetrics calculate_decay_cumulative(const HistorySpan& history, const Interval_Params& params, double half_life);
+
+// streaming: one sample at a time ---------------------------------------------------
+/*
+ * Ring buffer of the samples inside the window with running sums.
+ * push: amortized O(1) (add + evict), metrics: O(1) except the radius, O(window).
+ * Memory is bounded by the number of samples that fit in the window.
+ */
+class WindowAccumulator
+{
+    public:
+    WindowAccumulator(double window_seconds,
+                      const EGO_axis& base = EGO_axis{},
+                      const weight& w = weight{},
+                      const variable& v = variable{});
+
+    void push(const VADPoint& point);
+    CumulativeMetrics metrics() const;
+    std::size_t size() const { return count; }
+    void clear();
+
+    private:
+    struct Sample
+    {
+        double v, a, d, timestamp;
+        Interval_Terms terms;   // interval from the previous pushed sample
+    };
+
+    const Sample& at(std::size_t i) const { return ring[(head + i) % ring.size()]; }
+    void grow();
+    void refresh_sums();
+
+    double window_seconds;
+    Interval_Params params;
+
+    std::vector<Sample> ring;
+    std::size_t head = 0;
+    std::size_t count = 0;
+    std::size_t evicted_since_refresh = 0;
+
+    double sum_v = 0, sum_a = 0, sum_d = 0;
+    double sum_stress = 0, sum_reward = 0;
+};
+
+/*
+ * Exponentially decayed sums, S <- S * 2^(-dt / half_life) + x.
+ * push and metrics are O(1), memory is O(1).
+ */
+class DecayAccumulator
+{
+    public:
+    DecayAccumulator(double half_life,
+                     const EGO_axis& base = EGO_axis{},
+                     const weight& w = weight{},
+                     const variable& v = variable{});
+
+    void push(const VADPoint& point);
+    CumulativeMetrics metrics() const;
+    bool empty() const { return !has_last; }
+    void clear();
+
+    private:
+    double half_life;
+    Interval_Params params;
+
+    bool has_last = false;
+    double last_timestamp = 0;
+
+    double weight_sum = 0;                  // decayed sample count
+    double sum_v = 0, sum_a = 0, sum_d = 0; // decayed moments
+    double sum_sq = 0;                      // decayed |x|^2
+    double stress = 0, reward = 0;          // decayed integrals
+};
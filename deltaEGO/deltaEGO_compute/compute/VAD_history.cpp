@@ -0,0 +1,109 @@
+#include "VAD_history.hpp"
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+VADHistory::VADHistory(const std::vector<VADPoint>& points)
+{
+    this->reserve(points.size());
+    for (const auto& point : points)
+        this->push_back(point);
+}
+
+//--------------------appending--------------------
+void VADHistory::push_back(const VADPoint& point)
+{
+    this->push_back(point.v, point.a, point.d, point.timestamp, this->intern_owner(point.owner));
+}
+
+void VADHistory::push_back(double V, double A, double D, double ts, std::uint32_t owner_id)
+{
+    if (owner_id >= this->owner_names.size())
+        throw std::out_of_range("owner id is not interned in this history");
+
+    // new run only when owner changes
+    if (this->runs.empty() || this->runs.back().owner_id != owner_id)
+        this->runs.push_back(OwnerRun{this->v.size(), owner_id});
+
+    this->v.push_back(V);
+    this->a.push_back(A);
+    this->d.push_back(D);
+    this->timestamp.push_back(ts);
+}
+
+void VADHistory::reserve(std::size_t n)
+{
+    this->v.reserve(n);
+    this->a.reserve(n);
+    this->d.reserve(n);
+    this->timestamp.reserve(n);
+}
+
+void VADHistory::clear()
+{
+    this->v.clear();
+    this->a.clear();
+    this->d.clear();
+    this->timestamp.clear();
+    this->runs.clear();
+    this->owner_names.clear();
+}
+
+std::uint32_t VADHistory::intern_owner(const std::string& owner)
+{
+    for (std::size_t i = 0; i < this->owner_names.size(); i++)
+    {
+        if (this->owner_names[i] == owner)
+            return static_cast<std::uint32_t>(i);
+    }
+
+    this->owner_names.push_back(owner);
+    return static_cast<std::uint32_t>(this->owner_names.size() - 1);
+}
+
+//--------------------reading--------------------
+HistorySpan VADHistory::span() const
+{
+    return HistorySpan{this->v.data(), this->a.data(), this->d.data(), this->timestamp.data(), this->v.size(), 1};
+}
+
+VADPoint VADHistory::at(std::size_t i) const
+{
+    if (i >= this->size())
+        throw std::out_of_range("history index out of range");
+
+    return VADPoint{this->v[i], this->a[i], this->d[i], this->timestamp[i], this->owner_name(this->owner_id_at(i))};
+}
+
+std::vector<VADPoint> VADHistory::to_points() const
+{
+    std::vector<VADPoint> points;
+    points.reserve(this->size());
+
+    // walk runs instead of searching owner per sample
+    for (std::size_t r = 0; r < this->runs.size(); r++)
+    {
+        const std::size_t end = (r + 1 < this->runs.size()) ? this->runs[r + 1].start : this->size();
+        const std::string& owner = this->owner_names[this->runs[r].owner_id];
+
+        for (std::size_t i = this->runs[r].start; i < end; i++)
+            points.push_back(VADPoint{this->v[i], this->a[i], this->d[i], this->timestamp[i], owner});
+    }
+    return points;
+}
+
+std::uint32_t VADHistory::owner_id_at(std::size_t i) const
+{
+    if (i >= this->size())
+        throw std::out_of_range("history index out of range");
+
+    // last run with start <= i
+    auto it = std::upper_bound(this->runs.begin(), this->runs.end(), i,
+                               [](std::size_t idx, const OwnerRun& run){ return idx < run.start; });
+    return std::prev(it)->owner_id;
+}
+
+const std::string& VADHistory::owner_name(std::uint32_t owner_id) const
+{
+    return this->owner_names.at(owner_id);
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "VAD.hpp"
+
+/*
+ * Read-only view of history columns (does not own memory).
+ * Sample i is (v[i*stride], a[i*stride], d[i*stride], timestamp[i*stride]).
+ * stride is counted in doubles: 1 for VADHistory columns, 4 for a C-ordered (n,4) array,
+ * itemsize/8 for a structured numpy array or a binary record file.
+ */
+struct HistorySpan
+{
+    const double* v = nullptr;
+    const double* a = nullptr;
+    const double* d = nullptr;
+    const double* timestamp = nullptr;
+    std::size_t size = 0;
+    std::size_t stride = 1;
+
+    double v_at(std::size_t i) const { return v[i * stride]; }
+    double a_at(std::size_t i) const { return a[i * stride]; }
+    double d_at(std::size_t i) const { return d[i * stride]; }
+    double timestamp_at(std::size_t i) const { return timestamp[i * stride]; }
+
+    VADPoint point(std::size_t i) const
+    {
+        return VADPoint{v_at(i), a_at(i), d_at(i), timestamp_at(i)};
+    }
+    HistorySpan sub(std::size_t begin, std::size_t end) const
+    {
+        const std::size_t offset = begin * stride;
+        return HistorySpan{v + offset, a + offset, d + offset, timestamp + offset, end - begin, stride};
+    }
+};
+
+/*
+ * Structure-of-arrays history.
+ * v/a/d/timestamp are separate contiguous columns (32 bytes per sample).
+ * Owners are interned: each name is stored once, and the owner column is
+ * run-length encoded, so a single-owner history pays nothing per sample for it.
+ */
+class VADHistory
+{
+    public:
+    // sample index where an owner run starts, and who owns it
+    struct OwnerRun
+    {
+        std::size_t start;
+        std::uint32_t owner_id;
+    };
+
+    std::vector<double> v;
+    std::vector<double> a;
+    std::vector<double> d;
+    std::vector<double> timestamp;
+
+    VADHistory() = default;
+    VADHistory(const std::vector<VADPoint>& points);
+
+    //--------------------appending--------------------
+    void push_back(const VADPoint& point);
+    void push_back(double V, double A, double D, double ts, std::uint32_t owner_id);
+    void reserve(std::size_t n);
+    void clear();
+
+    // returns id of owner name, adds it if it's new (linear scan: a scene has a handful of owners)
+    std::uint32_t intern_owner(const std::string& owner);
+
+    //--------------------reading--------------------
+    std::size_t size() const { return v.size(); }
+    bool empty() const { return v.empty(); }
+
+    HistorySpan span() const;
+    // rebuilds a VADPoint (with owner string) for sample i
+    VADPoint at(std::size_t i) const;
+    std::vector<VADPoint> to_points() const;
+
+    // O(log runs)
+    std::uint32_t owner_id_at(std::size_t i) const;
+    const std::string& owner_name(std::uint32_t owner_id) const;
+    const std::vector<std::string>& owners() const { return owner_names; }
+    const std::vector<OwnerRun>& owner_runs() const { return runs; }
+
+    private:
+    std::vector<std::string> owner_names;
+    std::vector<OwnerRun> runs;
+};
@@ -1,133 +1,1169 @@
-#include <pybind11/pybind11.h>
-#include <pybind11/stl.h> 
-#include "EGO_compute.hpp" 
-
-namespace py = pybind11;
-
-PYBIND11_MODULE(_core, m)
-{
-    m.doc() = "deltaEGO C++ VAD vector analysis module with parallel processing";
-
-    //Base Structs (VAD.hpp)
-    
-    py::class_<VADPoint>(m, "VADPoint")
-        // obj = VADPoint() 
-        .def(py::init<>()) 
-        // obj = VADPoint(v=..., a=...)
-        .def(py::init<double, double, double, double, std::string>(),
-            py::arg("v"),
-            py::arg("a"),
-            py::arg("d"),
-            py::arg("timestamp"),
-            py::arg("owner")
-        )
-        .def_readwrite("v", &VADPoint::v)
-        .def_readwrite("a", &VADPoint::a)
-        .def_readwrite("d", &VADPoint::d)
-        .def_readwrite("timestamp", &VADPoint::timestamp)
-        .def_readwrite("owner", &VADPoint::owner);
-
-    py::class_<VAD_ave>(m, "VAD_ave")
-        .def(py::init<>())
-        .def_readwrite("x", &VAD_ave::x)
-        .def_readwrite("y", &VAD_ave::y)
-        .def_readwrite("z", &VAD_ave::z)
-        .def_readwrite("radius", &VAD_ave::radius);
-
-    // Input Helper Structs (with default values)
-
-    py::class_<weight>(m, "weight")
-        .def(py::init<double, double, double, double, double>(),
-            py::arg("weightA_stress") = weight().weightA_stress,
-            py::arg("weightV_stress") = weight().weightV_stress,
-            py::arg("weightV_reward") = weight().weightV_reward,
-            py::arg("weightA_reward") = weight().weightA_reward,
-            py::arg("weight_k") = weight().weight_k
-        )
-        .def_readwrite("weightA_stress", &weight::weightA_stress)
-        .def_readwrite("weightV_stress", &weight::weightV_stress)
-        .def_readwrite("weightV_reward", &weight::weightV_reward)
-        .def_readwrite("weightA_reward", &weight::weightA_reward)
-        .def_readwrite("weight_k", &weight::weight_k);
-
-    py::class_<variable>(m, "variable")
-        .def(py::init<double, double>(),
-            py::arg("theta_0") = variable().theta_0,
-            py::arg("dampening_factor") = variable().dampening_factor
-        )
-        .def_readwrite("theta_0", &variable::theta_0)
-        .def_readwrite("dampening_factor", &variable::dampening_factor);
-
-    py::class_<EGO_axis>(m, "EGO_axis")
-        .def(py::init<>())
-        .def(py::init<VADPoint, double>(),
-            py::arg("baseline") = EGO_axis().baseline,
-            py::arg("stabilityRadius") = EGO_axis().stabilityRadius
-        )
-        .def_readwrite("baseline", &EGO_axis::baseline)
-        .def_readwrite("stabilityRadius", &EGO_axis::stabilityRadius);
-
-    // Output Helper Structs 
-
-    py::class_<InstantMetrics>(m, "InstantMetrics")
-        .def(py::init<>())
-        .def_readwrite("stress", &InstantMetrics::stress)
-        .def_readwrite("reward", &InstantMetrics::reward)
-        .def_readwrite("ratio_total", &InstantMetrics::ratio_total)
-        .def_readwrite("stress_ratio", &InstantMetrics::stress_ratio)
-        .def_readwrite("reward_ratio", &InstantMetrics::reward_ratio)
-        .def_readwrite("deviation", &InstantMetrics::deviation);
-
-    py::class_<DynamicMetrics>(m, "DynamicMetrics")
-        .def(py::init<>())
-        .def_readwrite("delta", &DynamicMetrics::delta)
-        .def_readwrite("affective_lability", &DynamicMetrics::affective_lability);
-
-    py::class_<CumulativeMetrics>(m, "CumulativeMetrics")
-        .def(py::init<>())
-        .def_readwrite("average_area", &CumulativeMetrics::average_area)
-        .def_readwrite("stress", &CumulativeMetrics::stress)
-        .def_readwrite("reward", &CumulativeMetrics::reward)
-        .def_readwrite("total", &CumulativeMetrics::total)
-        .def_readwrite("stress_ratio", &CumulativeMetrics::stress_ratio)
-        .def_readwrite("reward_ratio", &CumulativeMetrics::reward_ratio);
-
-    // Main Input Struct
-    
-    py::class_<compute_in>(m, "compute_in")
-        .def(py::init<
-            VADPoint,                  // current
-            std::vector<VADPoint>,     // history
-            std::optional<VADPoint>,   // prev
-            std::optional<EGO_axis>,   // emotion_base
-            std::optional<variable>,   // variables
-            std::optional<weight>      // weights
-        >(),
-            py::arg("current"),
-            py::arg("history"),
-            py::arg("prev") = std::nullopt,         
-            py::arg("emotion_base") = std::nullopt,
-            py::arg("variables") = std::nullopt,
-            py::arg("weights") = std::nullopt
-        )
-        .def_readwrite("current", &compute_in::current)
-        .def_readwrite("history", &compute_in::history) // std::vector <-> list
-        .def_readwrite("prev", &compute_in::prev)       // std::optional <-> None
-        .def_readwrite("emotion_base", &compute_in::emotion_base)
-        .def_readwrite("variables", &compute_in::variables)
-        .def_readwrite("weights", &compute_in::weights);
-
-    // Main Output Struct
-    
-    py::class_<AnalysisResult>(m, "AnalysisResult")
-        .def(py::init<>())
-        .def_readwrite("instant", &AnalysisResult::instant)
-        .def_readwrite("dynamics", &AnalysisResult::dynamics)
-        .def_readwrite("cumulative", &AnalysisResult::cumulative);
-
-    // Main Function
-    
-    m.def("compute", &EGO_compute, 
-          "Run the full deltaEGO analysis from an input bundle",
-          py::arg("user_in"));
-}
\ No newline at end of file
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h> 
+#include <pybind11/numpy.h>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include "EGO_compute.hpp" 
+#include "EGO_model.hpp"
+#include "EGO_batch.hpp"
+#include "EGO_window.hpp"
+#include "EGO_resample.hpp"
+#include "EGO_index.hpp"
+#include "EGO_series.hpp"
+#include "EGO_sweep.hpp"
+#include "EGO_baselines.hpp"
+#include "EGO_session.hpp"
+#include "EGO_compact.hpp"
+#include "EGO_owner.hpp"
+#include "EGO_events.hpp"
+#include "EGO_baseline.hpp"
+#include "EGO_filter.hpp"
+#ifdef DELTAEGO_HISTORY_LOG
+#include "EGO_log.hpp"
+#endif
+#ifdef DELTAEGO_TRACKER
+#include "EGO_tracker.hpp"
+#endif
+
+namespace py = pybind11;
+
+// numpy view of one column of AnalysisColumns / MetricSeries (no copy, keeps the owner alive)
+template <typename Columns, std::vector<double> Columns::*Column>
+py::array_t<double> column_view(py::object self)
+{
+    const std::vector<double>& column = self.cast<const Columns&>().*Column;
+    return py::array_t<double>(column.size(), column.data(), self);
+}
+
+PYBIND11_NUMPY_DTYPE(DetectorEvent, stream, timestamp, value, rule, kind);
+
+#ifdef DELTAEGO_HISTORY_LOG
+PYBIND11_NUMPY_DTYPE(LogRecord, v, a, d, timestamp, owner_id);
+#endif
+
+using double_array = py::array_t<double, py::array::c_style | py::array::forcecast>;
+using offset_array = py::array_t<std::int64_t, py::array::c_style | py::array::forcecast>;
+using owner_id_array = py::array_t<std::uint32_t, py::array::c_style | py::array::forcecast>;
+using stream_id_array = py::array_t<std::size_t, py::array::c_style | py::array::forcecast>;
+
+/*
+ * Builds a HistorySpan that reads a numpy array in place.
+ *  - (n, 4) float64 array, columns v, a, d, timestamp (any order: C, Fortran, sliced)
+ *  - 1-d structured array with float64 fields "v", "a", "d", "timestamp"
+ * If the memory can't be read as aligned doubles (float32, negative strides...), it is converted
+ * once to a C-ordered float64 (n, 4) array, which `keep_alive` then holds.
+ */
+HistorySpan history_span_from_array(py::array history, py::object& keep_alive)
+{
+    const auto aligned = [](const void* ptr, py::ssize_t stride_bytes)
+    {
+        return reinterpret_cast<std::uintptr_t>(ptr) % sizeof(double) == 0
+            && stride_bytes >= 0
+            && stride_bytes % static_cast<py::ssize_t>(sizeof(double)) == 0;
+    };
+
+    // structured array
+    if (history.ndim() == 1 && py::hasattr(history.dtype(), "fields") && !history.dtype().attr("fields").is_none())
+    {
+        py::dict fields = history.dtype().attr("fields");
+        const char* names[4] = {"v", "a", "d", "timestamp"};
+        const double* columns[4];
+        const char* base = static_cast<const char*>(history.data());
+        const py::ssize_t row_bytes = (history.shape(0) > 1) ? history.strides(0) : history.itemsize();
+
+        for (int k = 0; k < 4; k++)
+        {
+            if (!fields.contains(names[k]))
+                throw std::invalid_argument(std::string("structured history needs a field named '") + names[k] + "'");
+
+            py::tuple field = fields[names[k]];
+            py::dtype field_type = field[0].cast<py::dtype>();
+            const py::ssize_t offset = field[1].cast<py::ssize_t>();
+
+            if (!field_type.equal(py::dtype::of<double>()))
+                throw std::invalid_argument(std::string("field '") + names[k] + "' must be float64");
+
+            columns[k] = reinterpret_cast<const double*>(base + offset);
+            if (!aligned(columns[k], row_bytes))
+                throw std::invalid_argument("structured history is not 8-byte aligned");
+        }
+
+        keep_alive = history;
+        return HistorySpan{columns[0], columns[1], columns[2], columns[3],
+                           static_cast<std::size_t>(history.shape(0)),
+                           static_cast<std::size_t>(row_bytes / static_cast<py::ssize_t>(sizeof(double)))};
+    }
+
+    if (history.ndim() != 2 || history.shape(1) != 4)
+        throw std::invalid_argument("history array must have shape (n, 4): v, a, d, timestamp");
+
+    // float64 with 8-byte strides -> read in place
+    if (history.dtype().equal(py::dtype::of<double>())
+        && aligned(history.data(), history.strides(0))
+        && aligned(history.data(), history.strides(1)))
+    {
+        const double* base = static_cast<const double*>(history.data());
+        const std::size_t row = static_cast<std::size_t>(history.strides(0)) / sizeof(double);
+        const std::size_t column = static_cast<std::size_t>(history.strides(1)) / sizeof(double);
+
+        keep_alive = history;
+        return HistorySpan{base, base + column, base + 2 * column, base + 3 * column,
+                           static_cast<std::size_t>(history.shape(0)), row};
+    }
+
+    // anything else -> one conversion to C-ordered float64
+    double_array converted = double_array::ensure(history);
+    if (!converted)
+        throw py::error_already_set();
+
+    const double* base = converted.data();
+    keep_alive = converted;
+    return HistorySpan{base, base + 1, base + 2, base + 3, static_cast<std::size_t>(converted.shape(0)), 4};
+}
+
+PYBIND11_MODULE(_core, m)
+{
+    m.doc() = "deltaEGO C++ VAD vector analysis module with parallel processing";
+
+    //Base Structs (VAD.hpp)
+    
+    py::class_<VADPoint>(m, "VADPoint")
+        // obj = VADPoint() 
+        .def(py::init<>()) 
+        // obj = VADPoint(v=..., a=...)
+        .def(py::init<double, double, double, double, std::string>(),
+            py::arg("v"),
+            py::arg("a"),
+            py::arg("d"),
+            py::arg("timestamp"),
+            py::arg("owner")
+        )
+        .def_readwrite("v", &VADPoint::v)
+        .def_readwrite("a", &VADPoint::a)
+        .def_readwrite("d", &VADPoint::d)
+        .def_readwrite("timestamp", &VADPoint::timestamp)
+        .def_readwrite("owner", &VADPoint::owner);
+
+    // History (VAD_history.hpp)
+
+    py::class_<VADHistory>(m, "VADHistory")
+        .def(py::init<>())
+        // VADHistory([VADPoint, ...])
+        .def(py::init<const std::vector<VADPoint>&>(), py::arg("points"))
+        .def("append", py::overload_cast<const VADPoint&>(&VADHistory::push_back), py::arg("point"))
+        .def("append", 
+            [](VADHistory& self, double v, double a, double d, double timestamp, const std::string& owner)
+            {
+                self.push_back(v, a, d, timestamp, self.intern_owner(owner));
+            },
+            py::arg("v"),
+            py::arg("a"),
+            py::arg("d"),
+            py::arg("timestamp"),
+            py::arg("owner")
+        )
+        .def("reserve", &VADHistory::reserve, py::arg("n"))
+        .def("clear", &VADHistory::clear)
+        .def("__len__", &VADHistory::size)
+        .def("__getitem__", &VADHistory::at, py::arg("i"))
+        .def("to_list", &VADHistory::to_points)
+        .def("owner_id_at", &VADHistory::owner_id_at, py::arg("i"))
+        .def_property_readonly("owners", &VADHistory::owners);
+
+    // a plain list of VADPoint is still accepted wherever VADHistory is expected
+    py::implicitly_convertible<py::list, VADHistory>();
+
+#ifdef DELTAEGO_HISTORY_LOG
+    // Persistent history (EGO_log.hpp)
+
+    py::class_<HistoryLog>(m, "HistoryLog")
+        .def(py::init<const std::string&, std::size_t>(),
+            py::arg("path"),
+            py::arg("sync_every") = 64
+        )
+        .def("append", py::overload_cast<const VADPoint&>(&HistoryLog::append), py::arg("point"))
+        .def("append",
+            [](HistoryLog& self, double v, double a, double d, double timestamp, const std::string& owner)
+            {
+                self.append(v, a, d, timestamp, self.intern_owner(owner));
+            },
+            py::arg("v"),
+            py::arg("a"),
+            py::arg("d"),
+            py::arg("timestamp"),
+            py::arg("owner")
+        )
+        .def("flush", &HistoryLog::flush)
+        .def("__len__", &HistoryLog::size)
+        .def("__getitem__", &HistoryLog::at, py::arg("i"))
+        .def("to_history", &HistoryLog::to_history)
+        // structured numpy view of the mapped records (fields v, a, d, timestamp, owner_id), no copy
+        .def("as_array",
+            [](py::object self)
+            {
+                const HistoryLog& log = self.cast<const HistoryLog&>();
+                return py::array_t<LogRecord>(log.size(), log.records(), self);
+            })
+        .def_property_readonly("owners", &HistoryLog::owners)
+        .def_property_readonly("path", &HistoryLog::path);
+#endif
+
+    py::class_<VAD_ave>(m, "VAD_ave")
+        .def(py::init<>())
+        .def_readwrite("x", &VAD_ave::x)
+        .def_readwrite("y", &VAD_ave::y)
+        .def_readwrite("z", &VAD_ave::z)
+        .def_readwrite("radius", &VAD_ave::radius);
+
+    // Input Helper Structs (with default values)
+
+    py::class_<weight>(m, "weight")
+        .def(py::init<double, double, double, double, double>(),
+            py::arg("weightA_stress") = weight().weightA_stress,
+            py::arg("weightV_stress") = weight().weightV_stress,
+            py::arg("weightV_reward") = weight().weightV_reward,
+            py::arg("weightA_reward") = weight().weightA_reward,
+            py::arg("weight_k") = weight().weight_k
+        )
+        .def_readwrite("weightA_stress", &weight::weightA_stress)
+        .def_readwrite("weightV_stress", &weight::weightV_stress)
+        .def_readwrite("weightV_reward", &weight::weightV_reward)
+        .def_readwrite("weightA_reward", &weight::weightA_reward)
+        .def_readwrite("weight_k", &weight::weight_k);
+
+    // persona presets of EGO_model.hpp: these exact weights take the preset kernels
+    m.def("preset_weight",
+          [](const std::string& name)
+          {
+              if (name == "default") return preset_weight<default_weight_preset>();
+              if (name == "anxious") return preset_weight<anxious_weight_preset>();
+              if (name == "melancholic") return preset_weight<melancholic_weight_preset>();
+              if (name == "thrill_seeker") return preset_weight<thrill_seeker_weight_preset>();
+              throw std::invalid_argument("unknown weight preset '" + name + "'");
+          },
+          "Weights of a built-in preset: default, anxious, melancholic, thrill_seeker",
+          py::arg("name"));
+
+    py::class_<variable>(m, "variable")
+        .def(py::init<double, double>(),
+            py::arg("theta_0") = variable().theta_0,
+            py::arg("dampening_factor") = variable().dampening_factor
+        )
+        .def_readwrite("theta_0", &variable::theta_0)
+        .def_readwrite("dampening_factor", &variable::dampening_factor);
+
+    py::class_<EGO_axis>(m, "EGO_axis")
+        .def(py::init<>())
+        .def(py::init<VADPoint, double>(),
+            py::arg("baseline") = EGO_axis().baseline,
+            py::arg("stabilityRadius") = EGO_axis().stabilityRadius
+        )
+        .def_readwrite("baseline", &EGO_axis::baseline)
+        .def_readwrite("stabilityRadius", &EGO_axis::stabilityRadius);
+
+    // Output Helper Structs 
+
+    py::class_<InstantMetrics>(m, "InstantMetrics")
+        .def(py::init<>())
+        .def_readwrite("stress", &InstantMetrics::stress)
+        .def_readwrite("reward", &InstantMetrics::reward)
+        .def_readwrite("ratio_total", &InstantMetrics::ratio_total)
+        .def_readwrite("stress_ratio", &InstantMetrics::stress_ratio)
+        .def_readwrite("reward_ratio", &InstantMetrics::reward_ratio)
+        .def_readwrite("deviation", &InstantMetrics::deviation);
+
+    py::class_<DynamicMetrics>(m, "DynamicMetrics")
+        .def(py::init<>())
+        .def_readwrite("delta", &DynamicMetrics::delta)
+        .def_readwrite("affective_lability", &DynamicMetrics::affective_lability);
+
+    py::class_<CumulativeMetrics>(m, "CumulativeMetrics")
+        .def(py::init<>())
+        .def_readwrite("average_area", &CumulativeMetrics::average_area)
+        .def_readwrite("stress", &CumulativeMetrics::stress)
+        .def_readwrite("reward", &CumulativeMetrics::reward)
+        .def_readwrite("total", &CumulativeMetrics::total)
+        .def_readwrite("stress_ratio", &CumulativeMetrics::stress_ratio)
+        .def_readwrite("reward_ratio", &CumulativeMetrics::reward_ratio);
+
+    py::class_<LabilityMetrics>(m, "LabilityMetrics")
+        .def(py::init<>())
+        .def_readonly("mean", &LabilityMetrics::mean)
+        .def_readonly("max", &LabilityMetrics::max)
+        .def_readonly("above_threshold", &LabilityMetrics::above_threshold)
+        .def_readonly("count", &LabilityMetrics::count)
+        .def_property_readonly("rolling", &column_view<LabilityMetrics, &LabilityMetrics::rolling>);
+
+    py::enum_<math_precision>(m, "math_precision")
+        .value("exact", math_precision::exact)
+        .value("fast", math_precision::fast);
+
+    py::class_<lability_option>(m, "lability_option")
+        .def(py::init<double, double, math_precision>(),
+            py::arg("threshold") = lability_option().threshold,
+            py::arg("window_seconds") = lability_option().window_seconds,
+            py::arg("precision") = lability_option().precision
+        )
+        .def_readwrite("threshold", &lability_option::threshold)
+        .def_readwrite("window_seconds", &lability_option::window_seconds)
+        .def_readwrite("precision", &lability_option::precision);
+
+    py::enum_<cumulative_mode>(m, "cumulative_mode")
+        .value("lifetime", cumulative_mode::lifetime)
+        .value("window", cumulative_mode::window)
+        .value("decay", cumulative_mode::decay)
+        .value("resampled", cumulative_mode::resampled);
+
+    py::enum_<resample_mode>(m, "resample_mode")
+        .value("linear", resample_mode::linear)
+        .value("hold", resample_mode::hold);
+
+    py::class_<cumulative_option>(m, "cumulative_option")
+        .def(py::init<cumulative_mode, double, double, double, resample_mode>(),
+            py::arg("mode") = cumulative_option().mode,
+            py::arg("window_seconds") = cumulative_option().window_seconds,
+            py::arg("half_life") = cumulative_option().half_life,
+            py::arg("resample_step") = cumulative_option().resample_step,
+            py::arg("resample") = cumulative_option().resample
+        )
+        .def_readwrite("mode", &cumulative_option::mode)
+        .def_readwrite("window_seconds", &cumulative_option::window_seconds)
+        .def_readwrite("half_life", &cumulative_option::half_life)
+        .def_readwrite("resample_step", &cumulative_option::resample_step)
+        .def_readwrite("resample", &cumulative_option::resample);
+
+    // Main Input Struct
+    
+    py::class_<compute_in>(m, "compute_in")
+        .def(py::init<
+            VADPoint,                  // current
+            VADHistory,                // history
+            std::optional<VADPoint>,   // prev
+            std::optional<EGO_axis>,   // emotion_base
+            std::optional<variable>,   // variables
+            std::optional<weight>,     // weights
+            std::optional<cumulative_option>, // cumulative
+            unsigned int               // threads
+        >(),
+            py::arg("current"),
+            py::arg("history"),
+            py::arg("prev") = std::nullopt,         
+            py::arg("emotion_base") = std::nullopt,
+            py::arg("variables") = std::nullopt,
+            py::arg("weights") = std::nullopt,
+            py::arg("cumulative") = std::nullopt,
+            py::arg("threads") = 1
+        )
+        .def_readwrite("current", &compute_in::current)
+        .def_readwrite("history", &compute_in::history) // VADHistory (a list also works)
+        .def_readwrite("prev", &compute_in::prev)       // std::optional <-> None
+        .def_readwrite("emotion_base", &compute_in::emotion_base)
+        .def_readwrite("variables", &compute_in::variables)
+        .def_readwrite("weights", &compute_in::weights)
+        .def_readwrite("cumulative", &compute_in::cumulative) // None = lifetime
+        .def_readwrite("threads", &compute_in::threads)       // 0 = every hardware thread
+        .def_readwrite("baselines", &compute_in::baselines)   // list[EGO_axis] for compute_baselines
+        .def_readwrite("lability", &compute_in::lability);    // lability_option or None
+
+    // Main Output Struct
+    
+    py::class_<AnalysisResult>(m, "AnalysisResult")
+        .def(py::init<>())
+        .def_readwrite("instant", &AnalysisResult::instant)
+        .def_readwrite("dynamics", &AnalysisResult::dynamics)
+        .def_readwrite("cumulative", &AnalysisResult::cumulative)
+        .def_readwrite("lability", &AnalysisResult::lability);  // None unless compute_in.lability is set
+
+    // Batch Output Struct (every attribute is a numpy column)
+
+    py::class_<AnalysisColumns>(m, "AnalysisColumns")
+        .def(py::init<>())
+        .def("__len__", &AnalysisColumns::size)
+        .def_property_readonly("instant_stress", &column_view<AnalysisColumns, &AnalysisColumns::instant_stress>)
+        .def_property_readonly("instant_reward", &column_view<AnalysisColumns, &AnalysisColumns::instant_reward>)
+        .def_property_readonly("instant_ratio_total", &column_view<AnalysisColumns, &AnalysisColumns::instant_ratio_total>)
+        .def_property_readonly("instant_stress_ratio", &column_view<AnalysisColumns, &AnalysisColumns::instant_stress_ratio>)
+        .def_property_readonly("instant_reward_ratio", &column_view<AnalysisColumns, &AnalysisColumns::instant_reward_ratio>)
+        .def_property_readonly("deviation", &column_view<AnalysisColumns, &AnalysisColumns::deviation>)
+        .def_property_readonly("delta_v", &column_view<AnalysisColumns, &AnalysisColumns::delta_v>)
+        .def_property_readonly("delta_a", &column_view<AnalysisColumns, &AnalysisColumns::delta_a>)
+        .def_property_readonly("delta_d", &column_view<AnalysisColumns, &AnalysisColumns::delta_d>)
+        .def_property_readonly("affective_lability", &column_view<AnalysisColumns, &AnalysisColumns::affective_lability>)
+        .def_property_readonly("average_x", &column_view<AnalysisColumns, &AnalysisColumns::average_x>)
+        .def_property_readonly("average_y", &column_view<AnalysisColumns, &AnalysisColumns::average_y>)
+        .def_property_readonly("average_z", &column_view<AnalysisColumns, &AnalysisColumns::average_z>)
+        .def_property_readonly("average_radius", &column_view<AnalysisColumns, &AnalysisColumns::average_radius>)
+        .def_property_readonly("cumulative_stress", &column_view<AnalysisColumns, &AnalysisColumns::cumulative_stress>)
+        .def_property_readonly("cumulative_reward", &column_view<AnalysisColumns, &AnalysisColumns::cumulative_reward>)
+        .def_property_readonly("cumulative_total", &column_view<AnalysisColumns, &AnalysisColumns::cumulative_total>)
+        .def_property_readonly("cumulative_stress_ratio", &column_view<AnalysisColumns, &AnalysisColumns::cumulative_stress_ratio>)
+        .def_property_readonly("cumulative_reward_ratio", &column_view<AnalysisColumns, &AnalysisColumns::cumulative_reward_ratio>);
+
+    py::class_<MetricSeries>(m, "MetricSeries")
+        .def(py::init<>())
+        .def("__len__", &MetricSeries::size)
+        .def_property_readonly("instant_stress", &column_view<MetricSeries, &MetricSeries::instant_stress>)
+        .def_property_readonly("instant_reward", &column_view<MetricSeries, &MetricSeries::instant_reward>)
+        .def_property_readonly("instant_ratio_total", &column_view<MetricSeries, &MetricSeries::instant_ratio_total>)
+        .def_property_readonly("instant_stress_ratio", &column_view<MetricSeries, &MetricSeries::instant_stress_ratio>)
+        .def_property_readonly("instant_reward_ratio", &column_view<MetricSeries, &MetricSeries::instant_reward_ratio>)
+        .def_property_readonly("deviation", &column_view<MetricSeries, &MetricSeries::deviation>)
+        .def_property_readonly("delta_v", &column_view<MetricSeries, &MetricSeries::delta_v>)
+        .def_property_readonly("delta_a", &column_view<MetricSeries, &MetricSeries::delta_a>)
+        .def_property_readonly("delta_d", &column_view<MetricSeries, &MetricSeries::delta_d>)
+        .def_property_readonly("affective_lability", &column_view<MetricSeries, &MetricSeries::affective_lability>);
+
+    // Main Function
+    
+    m.def("compute", py::overload_cast<const compute_in&>(&EGO_compute), 
+          "Run the full deltaEGO analysis from an input bundle",
+          py::arg("user_in"));
+
+    // same analysis without building a compute_in: history is a VADHistory ...
+    m.def("compute",
+          [](const VADPoint& current,
+             const VADHistory& history,
+             std::optional<VADPoint> prev,
+             std::optional<EGO_axis> emotion_base,
+             std::optional<variable> variables,
+             std::optional<weight> weights,
+             unsigned int threads)
+          {
+              py::gil_scoped_release release;
+              return EGO_compute(current, history.span(), prev, emotion_base, variables, weights, threads);
+          },
+          "Run the full deltaEGO analysis on a VADHistory (no copy)",
+          py::arg("current"),
+          py::arg("history"),
+          py::arg("prev") = std::nullopt,
+          py::arg("emotion_base") = std::nullopt,
+          py::arg("variables") = std::nullopt,
+          py::arg("weights") = std::nullopt,
+          py::arg("threads") = 1);
+
+#ifdef DELTAEGO_HISTORY_LOG
+    // ... or a HistoryLog read straight from its mapping
+    m.def("compute",
+          [](const VADPoint& current,
+             const HistoryLog& history,
+             std::optional<VADPoint> prev,
+             std::optional<EGO_axis> emotion_base,
+             std::optional<variable> variables,
+             std::optional<weight> weights,
+             unsigned int threads)
+          {
+              const HistorySpan span = history.span();
+
+              py::gil_scoped_release release;
+              return EGO_compute(current, span, prev, emotion_base, variables, weights, threads);
+          },
+          "Run the full deltaEGO analysis on a HistoryLog (mapped file, no copy)",
+          py::arg("current"),
+          py::arg("history"),
+          py::arg("prev") = std::nullopt,
+          py::arg("emotion_base") = std::nullopt,
+          py::arg("variables") = std::nullopt,
+          py::arg("weights") = std::nullopt,
+          py::arg("threads") = 1);
+#endif
+
+    // ... or a numpy array read in place through the buffer protocol
+    m.def("compute",
+          [](const VADPoint& current,
+             py::array history,
+             std::optional<VADPoint> prev,
+             std::optional<EGO_axis> emotion_base,
+             std::optional<variable> variables,
+             std::optional<weight> weights,
+             unsigned int threads)
+          {
+              py::object keep_alive;
+              const HistorySpan span = history_span_from_array(history, keep_alive);
+
+              py::gil_scoped_release release;
+              return EGO_compute(current, span, prev, emotion_base, variables, weights, threads);
+          },
+          "Run the full deltaEGO analysis on a numpy history: (n, 4) float64 [v, a, d, timestamp] "
+          "or a structured array with float64 fields v, a, d, timestamp",
+          py::arg("current"),
+          py::arg("history").noconvert(),
+          py::arg("prev") = std::nullopt,
+          py::arg("emotion_base") = std::nullopt,
+          py::arg("variables") = std::nullopt,
+          py::arg("weights") = std::nullopt,
+          py::arg("threads") = 1);
+
+    // Group-by-owner (one AnalysisResult per participant of a mixed history)
+
+    py::class_<OwnerAnalysis>(m, "OwnerAnalysis")
+        .def_readonly("owner", &OwnerAnalysis::owner)
+        .def_readonly("count", &OwnerAnalysis::count)
+        .def_readonly("analysis", &OwnerAnalysis::analysis);
+
+    m.def("compute_by_owner",
+          [](const VADHistory& history,
+             std::optional<EGO_axis> emotion_base,
+             std::optional<variable> variables,
+             std::optional<weight> weights,
+             math_precision precision)
+          {
+              py::gil_scoped_release release;
+              return EGO_compute_by_owner(history, emotion_base, variables, weights, precision);
+          },
+          "Analyze every owner of a mixed VADHistory (same as splitting it per owner)",
+          py::arg("history"),
+          py::arg("emotion_base") = std::nullopt,
+          py::arg("variables") = std::nullopt,
+          py::arg("weights") = std::nullopt,
+          py::arg("precision") = math_precision::exact);
+
+    m.def("compute_by_owner",
+          [](py::array history,
+             const owner_id_array& owner_ids,
+             const std::vector<std::string>& owner_names,
+             std::optional<EGO_axis> emotion_base,
+             std::optional<variable> variables,
+             std::optional<weight> weights,
+             math_precision precision)
+          {
+              py::object keep_alive;
+              const HistorySpan span = history_span_from_array(history, keep_alive);
+              if (static_cast<std::size_t>(owner_ids.size()) != span.size)
+                  throw std::invalid_argument("owner_ids must have one entry per history sample");
+
+              py::gil_scoped_release release;
+              const auto runs = make_owner_runs(owner_ids.data(), span.size);
+              return EGO_compute_by_owner(span, runs, owner_names, emotion_base, variables, weights, precision);
+          },
+          "Analyze every owner of a numpy history; owner_ids[i] indexes owner_names",
+          py::arg("history").noconvert(),
+          py::arg("owner_ids"),
+          py::arg("owner_names"),
+          py::arg("emotion_base") = std::nullopt,
+          py::arg("variables") = std::nullopt,
+          py::arg("weights") = std::nullopt,
+          py::arg("precision") = math_precision::exact);
+
+    // Batch Functions (GIL is released while workers run)
+
+    m.def("compute_batch", &EGO_compute_batch,
+          "Run the analysis for many input bundles in parallel and return columns",
+          py::arg("sessions"),
+          py::arg("threads") = 0,
+          py::arg("precision") = math_precision::exact,
+          py::call_guard<py::gil_scoped_release>());
+
+    m.def("compute_batch_columnar",
+          [](const double_array& v,
+             const double_array& a,
+             const double_array& d,
+             const double_array& timestamp,
+             const offset_array& offsets,
+             std::optional<EGO_axis> emotion_base,
+             std::optional<variable> variables,
+             std::optional<weight> weights,
+             unsigned int threads,
+             math_precision precision)
+          {
+              const py::ssize_t n = v.size();
+              if (a.size() != n || d.size() != n || timestamp.size() != n)
+                  throw std::invalid_argument("v, a, d and timestamp must have the same length");
+              if (offsets.size() < 1)
+                  throw std::invalid_argument("offsets needs at least one entry");
+
+              history_columns_in columns;
+              columns.v = v.data();
+              columns.a = a.data();
+              columns.d = d.data();
+              columns.timestamp = timestamp.data();
+              columns.offsets = offsets.data();
+              columns.sessions = static_cast<std::size_t>(offsets.size() - 1);
+              columns.emotion_base = std::move(emotion_base);
+              columns.variables = std::move(variables);
+              columns.weights = std::move(weights);
+
+              if (offsets.at(offsets.size() - 1) > n)
+                  throw std::invalid_argument("offsets point past the end of the history arrays");
+
+              py::gil_scoped_release release;
+              return EGO_compute_batch_columnar(columns, threads, precision);
+          },
+          "Run the analysis for concatenated histories split by offsets (CSR style)",
+          py::arg("v"),
+          py::arg("a"),
+          py::arg("d"),
+          py::arg("timestamp"),
+          py::arg("offsets"),
+          py::arg("emotion_base") = std::nullopt,
+          py::arg("variables") = std::nullopt,
+          py::arg("weights") = std::nullopt,
+          py::arg("threads") = 0,
+          py::arg("precision") = math_precision::exact);
+
+    // Per-sample series (dashboards): one O(n) pass instead of n compute calls
+
+    m.def("compute_series",
+          [](const VADHistory& history,
+             std::optional<EGO_axis> emotion_base,
+             std::optional<variable> variables,
+             std::optional<weight> weights,
+             unsigned int threads,
+             math_precision precision)
+          {
+              py::gil_scoped_release release;
+              return EGO_compute_series(history.span(), emotion_base, variables, weights, threads, precision);
+          },
+          "Instant and dynamic metrics of every sample of a VADHistory (row i: current = i, prev = i-1)",
+          py::arg("history"),
+          py::arg("emotion_base") = std::nullopt,
+          py::arg("variables") = std::nullopt,
+          py::arg("weights") = std::nullopt,
+          py::arg("threads") = 0,
+          py::arg("precision") = math_precision::exact);
+
+    m.def("compute_series",
+          [](py::array history,
+             std::optional<EGO_axis> emotion_base,
+             std::optional<variable> variables,
+             std::optional<weight> weights,
+             unsigned int threads,
+             math_precision precision)
+          {
+              py::object keep_alive;
+              const HistorySpan span = history_span_from_array(history, keep_alive);
+
+              py::gil_scoped_release release;
+              return EGO_compute_series(span, emotion_base, variables, weights, threads, precision);
+          },
+          "Instant and dynamic metrics of every sample of a numpy history",
+          py::arg("history").noconvert(),
+          py::arg("emotion_base") = std::nullopt,
+          py::arg("variables") = std::nullopt,
+          py::arg("weights") = std::nullopt,
+          py::arg("threads") = 0,
+          py::arg("precision") = math_precision::exact);
+
+#ifdef DELTAEGO_HISTORY_LOG
+    m.def("compute_series",
+          [](const HistoryLog& history,
+             std::optional<EGO_axis> emotion_base,
+             std::optional<variable> variables,
+             std::optional<weight> weights,
+             unsigned int threads,
+             math_precision precision)
+          {
+              const HistorySpan span = history.span();
+
+              py::gil_scoped_release release;
+              return EGO_compute_series(span, emotion_base, variables, weights, threads, precision);
+          },
+          "Instant and dynamic metrics of every sample of a HistoryLog",
+          py::arg("history"),
+          py::arg("emotion_base") = std::nullopt,
+          py::arg("variables") = std::nullopt,
+          py::arg("weights") = std::nullopt,
+          py::arg("threads") = 0,
+          py::arg("precision") = math_precision::exact);
+#endif
+
+    // Parameter sweep: one history, many weight / variable sets
+
+    py::class_<sweep_param>(m, "sweep_param")
+        .def(py::init<weight, variable>(),
+            py::arg("weights") = weight(),
+            py::arg("variables") = variable()
+        )
+        .def_readwrite("weights", &sweep_param::weights)
+        .def_readwrite("variables", &sweep_param::variables);
+
+    m.def("sweep_grid", &make_sweep_grid,
+          "Every (weights, variables) pair as a list of sweep_param, weights-major",
+          py::arg("weights"),
+          py::arg("variables"));
+
+    m.def("compute_sweep",
+          [](const VADPoint& current,
+             const VADHistory& history,
+             const std::vector<sweep_param>& params,
+             std::optional<VADPoint> prev,
+             std::optional<EGO_axis> emotion_base,
+             unsigned int threads,
+             math_precision precision)
+          {
+              py::gil_scoped_release release;
+              return EGO_compute_sweep(current, history.span(), prev, emotion_base, params, threads, precision);
+          },
+          "Run the analysis once per parameter set over one VADHistory (row k = params[k])",
+          py::arg("current"),
+          py::arg("history"),
+          py::arg("params"),
+          py::arg("prev") = std::nullopt,
+          py::arg("emotion_base") = std::nullopt,
+          py::arg("threads") = 0,
+          py::arg("precision") = math_precision::exact);
+
+    m.def("compute_sweep",
+          [](const VADPoint& current,
+             py::array history,
+             const std::vector<sweep_param>& params,
+             std::optional<VADPoint> prev,
+             std::optional<EGO_axis> emotion_base,
+             unsigned int threads,
+             math_precision precision)
+          {
+              py::object keep_alive;
+              const HistorySpan span = history_span_from_array(history, keep_alive);
+
+              py::gil_scoped_release release;
+              return EGO_compute_sweep(current, span, prev, emotion_base, params, threads, precision);
+          },
+          "Run the analysis once per parameter set over one numpy history (row k = params[k])",
+          py::arg("current"),
+          py::arg("history").noconvert(),
+          py::arg("params"),
+          py::arg("prev") = std::nullopt,
+          py::arg("emotion_base") = std::nullopt,
+          py::arg("threads") = 0,
+          py::arg("precision") = math_precision::exact);
+
+    // Multi-baseline: stress of one history against many EGO_axis in one pass
+
+    py::class_<BaselineColumns>(m, "BaselineColumns")
+        .def(py::init<>())
+        .def("__len__", &BaselineColumns::size)
+        .def_property_readonly("instant_stress", &column_view<BaselineColumns, &BaselineColumns::instant_stress>)
+        .def_property_readonly("deviation", &column_view<BaselineColumns, &BaselineColumns::deviation>)
+        .def_property_readonly("cumulative_stress", &column_view<BaselineColumns, &BaselineColumns::cumulative_stress>)
+        .def_property_readonly("cumulative_stress_ratio", &column_view<BaselineColumns, &BaselineColumns::cumulative_stress_ratio>)
+        .def_readonly("cumulative_reward", &BaselineColumns::cumulative_reward);
+
+    m.def("compute_baselines",
+          &EGO_compute_baselines,
+          "Stress / deviation / cumulative stress against every axis in compute_in.baselines "
+          "(row k = baselines[k]) in one traversal of the history",
+          py::arg("compute_in"),
+          py::call_guard<py::gil_scoped_release>());
+
+    // Uniform time grid (replaces pandas resampling before the analysis)
+
+    py::class_<resample_option>(m, "resample_option")
+        .def(py::init<double, resample_mode, std::size_t>(),
+            py::arg("step") = resample_option().step,
+            py::arg("mode") = resample_option().mode,
+            py::arg("max_gap_points") = resample_option().max_gap_points
+        )
+        .def_readwrite("step", &resample_option::step)
+        .def_readwrite("mode", &resample_option::mode)
+        .def_readwrite("max_gap_points", &resample_option::max_gap_points);
+
+    m.def("resample",
+          [](py::array history, const resample_option& option)
+          {
+              py::object keep_alive;
+              const HistorySpan span = history_span_from_array(history, keep_alive);
+
+              std::size_t rows;
+              {
+                  py::gil_scoped_release release;
+                  rows = resampled_size(span, option);
+              }
+
+              double_array out({static_cast<py::ssize_t>(rows), static_cast<py::ssize_t>(4)});
+              double* row = out.mutable_data();
+              {
+                  py::gil_scoped_release release;
+                  resample_history(span, option, [&](double V, double A, double D, double t)
+                  {
+                      row[0] = V; row[1] = A; row[2] = D; row[3] = t;
+                      row += 4;
+                  });
+              }
+              return out;
+          },
+          "Resample a numpy history onto a uniform time grid; returns (m, 4) float64 [v, a, d, timestamp]",
+          py::arg("history").noconvert(),
+          py::arg("option") = resample_option());
+
+    py::class_<Resampler>(m, "Resampler")
+        .def(py::init<resample_option>(), py::arg("option") = resample_option())
+        .def("push",
+             [](Resampler& self, const VADPoint& point)
+             {
+                 std::vector<double> rows;
+                 self.push(point.v, point.a, point.d, point.timestamp, [&](double V, double A, double D, double t)
+                 {
+                     rows.insert(rows.end(), {V, A, D, t});
+                 });
+
+                 double_array out({static_cast<py::ssize_t>(rows.size() / 4), static_cast<py::ssize_t>(4)});
+                 std::copy(rows.begin(), rows.end(), out.mutable_data());
+                 return out;
+             },
+             "Push one sample; returns the grid points it completed as (k, 4) float64",
+             py::arg("point"))
+        .def("reset", &Resampler::reset)
+        .def_property_readonly("step", &Resampler::step);
+
+    // Streaming cumulative metrics (one push per turn)
+
+    py::class_<WindowAccumulator>(m, "WindowAccumulator")
+        .def(py::init<double, EGO_axis, weight, variable>(),
+            py::arg("window_seconds"),
+            py::arg("emotion_base") = EGO_axis(),
+            py::arg("weights") = weight(),
+            py::arg("variables") = variable()
+        )
+        .def("push", &WindowAccumulator::push, py::arg("point"))
+        .def("metrics", &WindowAccumulator::metrics)
+        .def("clear", &WindowAccumulator::clear)
+        .def("__len__", &WindowAccumulator::size);
+
+    py::class_<DecayAccumulator>(m, "DecayAccumulator")
+        .def(py::init<double, EGO_axis, weight, variable>(),
+            py::arg("half_life"),
+            py::arg("emotion_base") = EGO_axis(),
+            py::arg("weights") = weight(),
+            py::arg("variables") = variable()
+        )
+        .def("push", &DecayAccumulator::push, py::arg("point"))
+        .def("metrics", &DecayAccumulator::metrics)
+        .def("clear", &DecayAccumulator::clear)
+        .def("empty", &DecayAccumulator::empty);
+
+    // Time-range queries over prefix sums
+
+    py::class_<HistoryIndex>(m, "HistoryIndex")
+        .def(py::init<EGO_axis, weight, variable>(),
+            py::arg("emotion_base") = EGO_axis(),
+            py::arg("weights") = weight(),
+            py::arg("variables") = variable()
+        )
+        .def(py::init([](const VADHistory& history, const EGO_axis& base, const weight& w, const variable& v)
+            {
+                return HistoryIndex(history.span(), base, w, v);
+            }),
+            py::arg("history"),
+            py::arg("emotion_base") = EGO_axis(),
+            py::arg("weights") = weight(),
+            py::arg("variables") = variable()
+        )
+        .def(py::init([](py::array history, const EGO_axis& base, const weight& w, const variable& v)
+            {
+                py::object keep_alive;
+                return HistoryIndex(history_span_from_array(history, keep_alive), base, w, v);
+            }),
+            py::arg("history").noconvert(),
+            py::arg("emotion_base") = EGO_axis(),
+            py::arg("weights") = weight(),
+            py::arg("variables") = variable()
+        )
+        .def("push", py::overload_cast<const VADPoint&>(&HistoryIndex::push), py::arg("point"))
+        .def("push", py::overload_cast<double, double, double, double>(&HistoryIndex::push),
+            py::arg("v"), py::arg("a"), py::arg("d"), py::arg("timestamp"))
+        .def("reserve", &HistoryIndex::reserve, py::arg("n"))
+        .def("clear", &HistoryIndex::clear)
+        .def("query", &HistoryIndex::query,
+            "Cumulative metrics of the samples with t0 <= timestamp <= t1, O(log n)",
+            py::arg("t0"), py::arg("t1"))
+        .def("count", &HistoryIndex::count, py::arg("t0"), py::arg("t1"))
+        .def("__len__", &HistoryIndex::size);
+
+    // Memory-bounded history (recent samples + summary blocks)
+
+    py::class_<compaction_policy>(m, "compaction_policy")
+        .def(py::init<std::size_t, std::size_t, std::size_t>(),
+            py::arg("recent") = compaction_policy().recent,
+            py::arg("block_size") = compaction_policy().block_size,
+            py::arg("max_blocks") = compaction_policy().max_blocks
+        )
+        .def_readwrite("recent", &compaction_policy::recent)
+        .def_readwrite("block_size", &compaction_policy::block_size)
+        .def_readwrite("max_blocks", &compaction_policy::max_blocks);
+
+    py::class_<SummaryBlock>(m, "SummaryBlock")
+        .def_readonly("count", &SummaryBlock::count)
+        .def_readonly("t_begin", &SummaryBlock::t_begin)
+        .def_readonly("t_end", &SummaryBlock::t_end)
+        .def_readonly("sum_v", &SummaryBlock::sum_v)
+        .def_readonly("sum_a", &SummaryBlock::sum_a)
+        .def_readonly("sum_d", &SummaryBlock::sum_d)
+        .def_readonly("stress", &SummaryBlock::stress)
+        .def_readonly("reward", &SummaryBlock::reward)
+        .def_readonly("dist_sum", &SummaryBlock::dist_sum)
+        .def_readonly("dist_error", &SummaryBlock::dist_error);
+
+    py::class_<CompactHistory>(m, "CompactHistory")
+        .def(py::init<compaction_policy, EGO_axis, weight, variable>(),
+            py::arg("policy") = compaction_policy(),
+            py::arg("emotion_base") = EGO_axis(),
+            py::arg("weights") = weight(),
+            py::arg("variables") = variable()
+        )
+        .def("push", py::overload_cast<const VADPoint&>(&CompactHistory::push), py::arg("point"))
+        .def("push", py::overload_cast<double, double, double, double>(&CompactHistory::push),
+            py::arg("v"), py::arg("a"), py::arg("d"), py::arg("timestamp"))
+        .def("clear", &CompactHistory::clear)
+        .def_property_readonly("blocks", &CompactHistory::blocks, py::return_value_policy::reference_internal)
+        .def_property_readonly("recent_size", [](const CompactHistory& history){ return history.recent().size; })
+        .def_property_readonly("policy", &CompactHistory::policy)
+        .def("average", [](const CompactHistory& history){ return calculate_average(history); },
+            "Exact center, approximate mean radius")
+        .def("cumulative", [](const CompactHistory& history){ return calculate_cumulative(history); })
+        .def("radius_error_bound", [](const CompactHistory& history){ return radius_error_bound(history); },
+            "Upper bound of |approximate radius - exact radius|")
+        .def("__len__", &CompactHistory::size);
+
+    m.def("compute", py::overload_cast<const CompactHistory&>(&EGO_compute),
+          "Analyze a CompactHistory: newest sample is current, the one before is prev",
+          py::arg("history"));
+
+    // Adaptive baseline (EWMA of VAD, O(1) per sample)
+
+    py::class_<AdaptiveBaseline>(m, "AdaptiveBaseline")
+        .def(py::init<double, VADPoint>(),
+            py::arg("time_constant"),
+            py::arg("initial") = VADPoint{0.0, 0.0, 0.0, 0.0}
+        )
+        .def("push", py::overload_cast<const VADPoint&>(&AdaptiveBaseline::push), py::arg("point"))
+        .def("push", py::overload_cast<double, double, double, double>(&AdaptiveBaseline::push),
+            py::arg("v"), py::arg("a"), py::arg("d"), py::arg("timestamp"))
+        .def("reset", &AdaptiveBaseline::reset, py::arg("initial"))
+        .def("value", &AdaptiveBaseline::value)
+        .def("apply", &AdaptiveBaseline::apply,
+            "EGO_axis with its baseline replaced by the current value",
+            py::arg("emotion_base"))
+        .def_property("time_constant", &AdaptiveBaseline::get_time_constant, &AdaptiveBaseline::set_time_constant);
+
+    // Noise smoothing (One-Euro filter) in front of search / compute
+
+    py::class_<filter_option>(m, "filter_option")
+        .def(py::init<double, double, double>(),
+            py::arg("min_cutoff") = filter_option().min_cutoff,
+            py::arg("beta") = filter_option().beta,
+            py::arg("d_cutoff") = filter_option().d_cutoff
+        )
+        .def_readwrite("min_cutoff", &filter_option::min_cutoff)
+        .def_readwrite("beta", &filter_option::beta)
+        .def_readwrite("d_cutoff", &filter_option::d_cutoff);
+
+    py::class_<OneEuroFilter>(m, "OneEuroFilter")
+        .def(py::init<filter_option>(), py::arg("option") = filter_option())
+        .def("filter", &OneEuroFilter::filter,
+            "Smoothed VADPoint (owner left empty)",
+            py::arg("V"), py::arg("A"), py::arg("D"), py::arg("timestamp"))
+        .def("reset", &OneEuroFilter::reset)
+        .def_property_readonly("option", &OneEuroFilter::option);
+
+    py::class_<FilterBank>(m, "FilterBank")
+        .def(py::init<std::size_t, filter_option>(),
+            py::arg("streams"),
+            py::arg("option") = filter_option()
+        )
+        // one tick of every stream: arrays of length streams, returns filtered (V, A, D) copies
+        .def("step",
+            [](FilterBank& self, const double_array& V, const double_array& A, const double_array& D, const double_array& timestamp)
+            {
+                const py::ssize_t n = static_cast<py::ssize_t>(self.size());
+                if (V.size() != n || A.size() != n || D.size() != n || timestamp.size() != n)
+                    throw std::invalid_argument("V, A, D and timestamp need one entry per stream");
+
+                py::array_t<double> out_v(n), out_a(n), out_d(n);
+                std::copy(V.data(), V.data() + n, out_v.mutable_data());
+                std::copy(A.data(), A.data() + n, out_a.mutable_data());
+                std::copy(D.data(), D.data() + n, out_d.mutable_data());
+                {
+                    py::gil_scoped_release release;
+                    self.step(out_v.mutable_data(), out_a.mutable_data(), out_d.mutable_data(), timestamp.data());
+                }
+                return py::make_tuple(out_v, out_a, out_d);
+            },
+            py::arg("V"), py::arg("A"), py::arg("D"), py::arg("timestamp"))
+        // sample i belongs to stream ids[i]
+        .def("step_some",
+            [](FilterBank& self, const stream_id_array& ids, const double_array& V, const double_array& A, const double_array& D,
+               const double_array& timestamp)
+            {
+                const py::ssize_t n = ids.size();
+                if (V.size() != n || A.size() != n || D.size() != n || timestamp.size() != n)
+                    throw std::invalid_argument("ids, V, A, D and timestamp must have the same length");
+
+                py::array_t<double> out_v(n), out_a(n), out_d(n);
+                std::copy(V.data(), V.data() + n, out_v.mutable_data());
+                std::copy(A.data(), A.data() + n, out_a.mutable_data());
+                std::copy(D.data(), D.data() + n, out_d.mutable_data());
+                {
+                    py::gil_scoped_release release;
+                    self.step_some(ids.data(), static_cast<std::size_t>(n),
+                                   out_v.mutable_data(), out_a.mutable_data(), out_d.mutable_data(), timestamp.data());
+                }
+                return py::make_tuple(out_v, out_a, out_d);
+            },
+            py::arg("ids"), py::arg("V"), py::arg("A"), py::arg("D"), py::arg("timestamp"))
+        .def("reset", &FilterBank::reset, py::arg("stream"))
+        .def("resize", &FilterBank::resize, py::arg("streams"))
+        .def("__len__", &FilterBank::size);
+
+    // Threshold / whiplash events (rules evaluated natively, drained in batches)
+
+    py::enum_<event_metric>(m, "event_metric")
+        .value("instant_stress", event_metric::instant_stress)
+        .value("instant_reward", event_metric::instant_reward)
+        .value("affective_lability", event_metric::affective_lability)
+        .value("deviation", event_metric::deviation)
+        .value("outside_radius", event_metric::outside_radius);
+
+    py::class_<event_rule>(m, "event_rule")
+        .def(py::init<event_metric, double, double, bool>(),
+            py::arg("metric") = event_rule().metric,
+            py::arg("threshold") = event_rule().threshold,
+            py::arg("hold_seconds") = event_rule().hold_seconds,
+            py::arg("report_end") = event_rule().report_end
+        )
+        .def_readwrite("metric", &event_rule::metric)
+        .def_readwrite("threshold", &event_rule::threshold)
+        .def_readwrite("hold_seconds", &event_rule::hold_seconds)
+        .def_readwrite("report_end", &event_rule::report_end);
+
+    py::class_<EventDetector, std::shared_ptr<EventDetector>>(m, "EventDetector")
+        .def(py::init<const std::vector<event_rule>&, std::size_t>(),
+            py::arg("rules"),
+            py::arg("queue_capacity") = 65536
+        )
+        .def("observe", &EventDetector::observe,
+            "Evaluate the rules on one AnalysisResult of a stream",
+            py::arg("stream"),
+            py::arg("timestamp"),
+            py::arg("result"),
+            py::arg("stability_radius") = EGO_axis().stabilityRadius,
+            py::call_guard<py::gil_scoped_release>())
+        // structured numpy array (fields stream, timestamp, value, rule, kind), kind 0 = start, 1 = end
+        .def("drain",
+            [](EventDetector& self, std::size_t max_events)
+            {
+                std::vector<DetectorEvent> events;
+                {
+                    py::gil_scoped_release release;
+                    events = self.drain(max_events);
+                }
+                return py::array_t<DetectorEvent>(events.size(), events.data());
+            },
+            py::arg("max_events") = 0)
+        .def("forget", &EventDetector::forget, py::arg("stream"))
+        .def_property_readonly("rules", &EventDetector::rules)
+        .def_property_readonly("dropped", &EventDetector::dropped);
+
+    // Every character's state behind sharded locks (Python only keeps the id)
+
+    py::class_<CharacterSettings>(m, "CharacterSettings")
+        .def(py::init<EGO_axis, variable, weight, double>(),
+            py::arg("emotion_base") = EGO_axis(),
+            py::arg("variables") = variable(),
+            py::arg("weights") = weight(),
+            py::arg("baseline_time_constant") = 0.0
+        )
+        .def_readwrite("emotion_base", &CharacterSettings::emotion_base)
+        .def_readwrite("variables", &CharacterSettings::variables)
+        .def_readwrite("weights", &CharacterSettings::weights)
+        .def_readwrite("baseline_time_constant", &CharacterSettings::baseline_time_constant); // 0 = static baseline
+
+    py::class_<SessionManager>(m, "SessionManager")
+        .def(py::init<std::size_t>(), py::arg("shard_count") = 64)
+        .def("create", &SessionManager::create,
+            "Add a character, returns False if the id already exists",
+            py::arg("id"),
+            py::arg("settings") = CharacterSettings())
+        .def("remove", &SessionManager::remove, py::arg("id"))
+        .def("__contains__", &SessionManager::contains, py::arg("id"))
+        .def("__len__", &SessionManager::size)
+        .def_property_readonly("shard_count", &SessionManager::shard_count)
+        .def("get_settings", &SessionManager::get_settings, py::arg("id"))
+        .def("set_settings", &SessionManager::set_settings, py::arg("id"), py::arg("settings"))
+        .def("history", &SessionManager::history, "Copy of the character's history", py::arg("id"))
+        .def("history_size", &SessionManager::history_size, py::arg("id"))
+        .def("clear_history", &SessionManager::clear_history, py::arg("id"))
+        .def("push", &SessionManager::push,
+            "Append one sample and analyze the character (unknown ids get default settings)",
+            py::arg("id"),
+            py::arg("V"),
+            py::arg("A"),
+            py::arg("D"),
+            py::arg("timestamp"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("push_batch", &SessionManager::push_batch,
+            "push() for many characters, one worker per shard, results in input order",
+            py::arg("ids"),
+            py::arg("V"),
+            py::arg("A"),
+            py::arg("D"),
+            py::arg("timestamp"),
+            py::arg("threads") = 0,
+            py::call_guard<py::gil_scoped_release>())
+        .def("memory_usage", &SessionManager::memory_usage, "Approximate heap bytes of all characters")
+        .def_property("detector", &SessionManager::get_detector, &SessionManager::set_detector);
+
+#ifdef DELTAEGO_TRACKER
+    // Search + history + analysis in one call (EGO_tracker.hpp)
+
+    // module_local: deltaEGO_VDB binds the same KDTree type
+    py::class_<KDTree, std::shared_ptr<KDTree>>(m, "EmotionTree", py::module_local())
+        .def("__len__", [](const KDTree& tree){ return tree.Emotions.size(); });
+
+    m.def("load_emotion_tree", &load_emotion_tree,
+          "Load VAD.json once; the tree is shared by every EGOTracker",
+          py::arg("json_path"));
+
+    py::class_<search_option>(m, "search_option")
+        .def(py::init<int, double, double, std::string>(),
+            py::arg("k") = search_option().k,
+            py::arg("d") = search_option().d,
+            py::arg("SIGMA") = search_option().SIGMA,
+            py::arg("opt") = search_option().opt
+        )
+        .def_readwrite("k", &search_option::k)
+        .def_readwrite("d", &search_option::d)
+        .def_readwrite("SIGMA", &search_option::SIGMA)
+        .def_readwrite("opt", &search_option::opt);
+
+    py::class_<TrackerHit>(m, "TrackerHit")
+        .def_readonly("emotion", &TrackerHit::emotion)
+        .def_readonly("distance_pow2", &TrackerHit::distance_pow2)
+        .def_readonly("similarity_percent", &TrackerHit::similarity_percent);
+
+    py::class_<TrackerResult>(m, "TrackerResult")
+        .def_readonly("hits", &TrackerResult::hits)
+        .def_readonly("analysis", &TrackerResult::analysis);
+
+    // one tracker per character; a tracker must not be stepped from two threads at once
+    py::class_<EGOTracker>(m, "EGOTracker")
+        .def(py::init<std::shared_ptr<KDTree>, const std::string&, std::optional<EGO_axis>,
+                      std::optional<variable>, std::optional<weight>, search_option>(),
+            py::arg("tree"),
+            py::arg("owner"),
+            py::arg("emotion_base") = std::nullopt,
+            py::arg("variables") = std::nullopt,
+            py::arg("weights") = std::nullopt,
+            py::arg("search") = search_option()
+        )
+        .def("step", &EGOTracker::step,
+            "Search, append to history and analyze in one call",
+            py::arg("V"),
+            py::arg("A"),
+            py::arg("D"),
+            py::arg("timestamp"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("clear", &EGOTracker::clear)
+        .def("set_detector", &EGOTracker::set_detector, py::arg("detector"), py::arg("stream"))
+        .def("set_adaptive_baseline", &EGOTracker::set_adaptive_baseline,
+            "> 0: baseline follows an EWMA of this tracker's samples, 0: static again",
+            py::arg("time_constant"))
+        .def_property_readonly("baseline", &EGOTracker::baseline)
+        .def("set_filter", &EGOTracker::set_filter,
+            "Smooth V/A/D before search and history (None: raw values)",
+            py::arg("option"))
+        .def_property_readonly("history", &EGOTracker::history, py::return_value_policy::reference_internal)
+        .def_property_readonly("settings", &EGOTracker::settings, py::return_value_policy::reference_internal)
+        .def_property_readonly("search", &EGOTracker::search, py::return_value_policy::reference_internal);
+#endif
+}
@@ -1,35 +1,163 @@
-from ._core import (
-    # Base Structs
-    VADPoint,
-    VAD_ave,
-
-    # Input Structs
-    weight,
-    variable,
-    EGO_axis,
-    compute_in,
-
-    # Output Structs
-    InstantMetrics,
-    DynamicMetrics,
-    CumulativeMetrics,
-    AnalysisResult,
-
-    # Main Function
-    compute
-)
-
-__all__ = [
-    "compute",
-    "deltaEGO_compute",
-    "compute_in",
-    "AnalysisResult",
-    "VADPoint",
-    "VAD_ave",
-    "weight",
-    "variable",
-    "EGO_axis",
-    "InstantMetrics",
-    "DynamicMetrics",
-    "CumulativeMetrics",
+from ._core import (
+    # Base Structs
+    VADPoint,
+    VAD_ave,
+    VADHistory,
+
+    # Input Structs
+    weight,
+    variable,
+    EGO_axis,
+    compute_in,
+    cumulative_mode,
+    cumulative_option,
+    resample_mode,
+    resample_option,
+    sweep_param,
+    lability_option,
+    math_precision,
+    preset_weight,
+
+    # Output Structs
+    InstantMetrics,
+    DynamicMetrics,
+    CumulativeMetrics,
+    LabilityMetrics,
+    AnalysisResult,
+    AnalysisColumns,
+    MetricSeries,
+
+    # Main Function
+    compute,
+
+    # Group-by-owner
+    OwnerAnalysis,
+    compute_by_owner,
+
+    # Batch Functions
+    compute_batch,
+    compute_batch_columnar,
+
+    # Series Functions
+    compute_series,
+
+    # Parameter Sweep
+    sweep_grid,
+    compute_sweep,
+
+    # Multi-baseline
+    BaselineColumns,
+    compute_baselines,
+
+    # Uniform Time Grid
+    resample,
+    Resampler,
+
+    # Streaming Cumulative Metrics
+    WindowAccumulator,
+    DecayAccumulator,
+
+    # Time-range Queries
+    HistoryIndex,
+
+    # Memory-bounded History
+    compaction_policy,
+    SummaryBlock,
+    CompactHistory,
+
+    # Adaptive Baseline
+    AdaptiveBaseline,
+
+    # Noise Smoothing
+    filter_option,
+    OneEuroFilter,
+    FilterBank,
+
+    # Event Detector
+    event_metric,
+    event_rule,
+    EventDetector,
+
+    # Multi-character State
+    CharacterSettings,
+    SessionManager
+)
+
+# persistent history log is only built on POSIX
+try:
+    from ._core import HistoryLog
+except ImportError:
+    HistoryLog = None
+
+# search + analysis in one call, only built when deltaEGO_VDB sources are found
+try:
+    from ._core import (
+        EmotionTree,
+        load_emotion_tree,
+        search_option,
+        TrackerHit,
+        TrackerResult,
+        EGOTracker
+    )
+except ImportError:
+    EmotionTree = load_emotion_tree = search_option = TrackerHit = TrackerResult = EGOTracker = None
+
+__all__ = [
+    "compute",
+    "compute_by_owner",
+    "OwnerAnalysis",
+    "compute_batch",
+    "compute_batch_columnar",
+    "compute_series",
+    "compute_sweep",
+    "compute_baselines",
+    "resample",
+    "resample_mode",
+    "resample_option",
+    "Resampler",
+    "BaselineColumns",
+    "sweep_grid",
+    "sweep_param",
+    "deltaEGO_compute",
+    "compute_in",
+    "cumulative_mode",
+    "cumulative_option",
+    "WindowAccumulator",
+    "DecayAccumulator",
+    "HistoryIndex",
+    "compaction_policy",
+    "SummaryBlock",
+    "CompactHistory",
+    "HistoryLog",
+    "AdaptiveBaseline",
+    "filter_option",
+    "OneEuroFilter",
+    "FilterBank",
+    "event_metric",
+    "event_rule",
+    "EventDetector",
+    "CharacterSettings",
+    "SessionManager",
+    "EmotionTree",
+    "load_emotion_tree",
+    "search_option",
+    "TrackerHit",
+    "TrackerResult",
+    "EGOTracker",
+    "AnalysisResult",
+    "VADPoint",
+    "VAD_ave",
+    "VADHistory",
+    "weight",
+    "variable",
+    "EGO_axis",
+    "InstantMetrics",
+    "DynamicMetrics",
+    "CumulativeMetrics",
+    "LabilityMetrics",
+    "lability_option",
+    "math_precision",
+    "preset_weight",
+    "AnalysisColumns",
+    "MetricSeries",
 ]
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "test_common.hpp"
+#include "EGO_baselines.hpp"
+
+// EGO_compute_baselines row k vs EGO_compute with emotion_base = baselines[k]
+TEST_CASE(baselines)
+{
+    const VADHistory history = random_history(5000, 21);
+    const weight w{0.6, 0.4, 0.45, 0.55, 1.1};
+    const variable vars{0.1, 0.2};
+
+    compute_in in;
+    in.history_view = history.span();
+    in.current = history.at(history.size() - 1);
+    in.prev = history.at(history.size() - 2);
+    in.weights = w;
+    in.variables = vars;
+    // radius 0 and negative never dampen, radius 2 dampens nearly everything
+    in.baselines = {EGO_axis{}, EGO_axis{VADPoint{0.3, -0.2, 0.1, 0.0}, 0.5}, EGO_axis{VADPoint{-0.5, 0.5, 0.0, 0.0}, 0.0},
+                    EGO_axis{VADPoint{0.0, 0.0, 0.0, 0.0}, -1.0}, EGO_axis{VADPoint{0.1, 0.1, 0.1, 0.0}, 2.0}};
+
+    const BaselineColumns out = EGO_compute_baselines(in);
+    CHECK(out.size() == in.baselines.size());
+
+    for (std::size_t k = 0; k < in.baselines.size() && k < out.size(); k++)
+    {
+        compute_in single = in;
+        single.baselines.clear();
+        single.emotion_base = in.baselines[k];
+        const AnalysisResult expect = EGO_compute(single);
+
+        CHECK(close(out.instant_stress[k], expect.instant.stress, 1e-12));
+        CHECK(close(out.deviation[k], expect.instant.deviation, 1e-12));
+        CHECK(close(out.cumulative_stress[k], expect.cumulative.stress));
+        CHECK(close(out.cumulative_reward, expect.cumulative.reward));
+        CHECK(close(out.cumulative_stress_ratio[k], expect.cumulative.stress_ratio));
+    }
+
+    // empty list: emotion_base alone
+    compute_in fallback = in;
+    fallback.baselines.clear();
+    fallback.emotion_base = in.baselines[1];
+    const BaselineColumns one = EGO_compute_baselines(fallback);
+    CHECK(one.size() == 1);
+    CHECK(one.size() == 1 && one.cumulative_stress[0] == out.cumulative_stress[1]);
+}
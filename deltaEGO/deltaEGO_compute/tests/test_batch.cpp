@@ -0,0 +1,74 @@
+#include "test_common.hpp"
+#include "EGO_batch.hpp"
+#include <stdexcept>
+
+namespace
+{
+    bool same_row(const AnalysisColumns& columns, std::size_t i, const AnalysisResult& r)
+    {
+        return columns.instant_stress[i] == r.instant.stress && columns.instant_reward[i] == r.instant.reward
+            && columns.deviation[i] == r.instant.deviation && columns.affective_lability[i] == r.dynamics.affective_lability
+            && columns.delta_v[i] == r.dynamics.delta.v
+            && columns.average_x[i] == r.cumulative.average_area.x && columns.average_radius[i] == r.cumulative.average_area.radius
+            && columns.cumulative_stress[i] == r.cumulative.stress && columns.cumulative_reward[i] == r.cumulative.reward
+            && columns.cumulative_total[i] == r.cumulative.total;
+    }
+}
+
+// EGO_compute_batch / EGO_compute_batch_columnar vs one EGO_compute per session
+TEST_CASE(batch)
+{
+    const std::size_t sessions = 40;
+    const EGO_axis base{VADPoint{0.0, 0.1, 0.0, 0.0}, 0.25};
+    const weight w{0.6, 0.4, 0.5, 0.5, 0.8};
+
+    std::vector<compute_in> inputs;
+    std::vector<double> v, a, d, ts;
+    std::vector<std::int64_t> offsets{0};
+    for (std::size_t s = 0; s < sessions; s++)
+    {
+        // empty, single-sample and long sessions
+        const VADHistory history = random_history((s % 10 == 0) ? s / 10 : 50 * s, 100 + s);
+        for (std::size_t i = 0; i < history.size(); i++)
+        {
+            const VADPoint p = history.at(i);
+            v.push_back(p.v); a.push_back(p.a); d.push_back(p.d); ts.push_back(p.timestamp);
+        }
+        offsets.push_back(static_cast<std::int64_t>(v.size()));
+
+        compute_in in;
+        in.history = history;
+        in.current = history.empty() ? VADPoint{0.0, 0.0, 0.0, 0.0} : history.at(history.size() - 1);
+        if (history.size() > 1)
+            in.prev = history.at(history.size() - 2);
+        in.emotion_base = base;
+        in.weights = w;
+        inputs.push_back(in);
+    }
+
+    const AnalysisColumns batch = EGO_compute_batch(inputs, 4);
+    history_columns_in columns;
+    columns.v = v.data(); columns.a = a.data(); columns.d = d.data(); columns.timestamp = ts.data();
+    columns.offsets = offsets.data();
+    columns.sessions = sessions;
+    columns.emotion_base = base;
+    columns.weights = w;
+    const AnalysisColumns columnar = EGO_compute_batch_columnar(columns, 3);
+
+    CHECK(batch.size() == sessions && columnar.size() == sessions);
+    for (std::size_t s = 0; s < sessions && s < batch.size() && s < columnar.size(); s++)
+    {
+        const AnalysisResult expect = EGO_compute(inputs[s]);
+        CHECK(same_row(batch, s, expect));
+        CHECK(same_row(columnar, s, expect));
+    }
+
+    // bad offsets are rejected before any work
+    std::vector<std::int64_t> bad{0, 10, 5};
+    columns.offsets = bad.data();
+    columns.sessions = 2;
+    bool threw = false;
+    try { EGO_compute_batch_columnar(columns); }
+    catch (const std::invalid_argument&) { threw = true; }
+    CHECK(threw);
+}
@@ -0,0 +1,108 @@
+#pragma once
+/*
+ * Helpers shared by the native tests: checks, case registration, random histories.
+ * Every tests/test_<case>.cpp registers its cases with TEST_CASE; ego_compute_tests runs them.
+ */
+#include "EGO_compute.hpp"
+#include "VAD_history.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+// registration ----------------------------------------------------------------------
+struct TestCase
+{
+    const char* name;
+    void (*run)();
+};
+
+std::vector<TestCase>& test_cases();
+int& test_failures();
+void test_check(bool ok, const char* what, const char* file, int line);
+
+struct TestRegistrar
+{
+    TestRegistrar(const char* name, void (*run)()) { test_cases().push_back(TestCase{name, run}); }
+};
+
+// TEST_CASE(window) { ... } runs as `ego_compute_tests window`
+#define TEST_CASE(name) \
+    static void test_##name(); \
+    static const TestRegistrar registrar_##name(#name, test_##name); \
+    static void test_##name()
+
+#define CHECK(cond) test_check((cond), #cond, __FILE__, __LINE__)
+
+// comparisons -----------------------------------------------------------------------
+// relative tolerance for paths that only differ in summation order
+inline bool close(double a, double b, double tol = 1e-9)
+{
+    return std::fabs(a - b) <= tol * std::max({1.0, std::fabs(a), std::fabs(b)});
+}
+
+inline bool same_cumulative(const CumulativeMetrics& x, const CumulativeMetrics& y)
+{
+    return x.stress == y.stress && x.reward == y.reward && x.total == y.total
+        && x.average_area.x == y.average_area.x && x.average_area.y == y.average_area.y
+        && x.average_area.z == y.average_area.z && x.average_area.radius == y.average_area.radius;
+}
+
+inline bool close_cumulative(const CumulativeMetrics& x, const CumulativeMetrics& y, double tol = 1e-9)
+{
+    return close(x.stress, y.stress, tol) && close(x.reward, y.reward, tol)
+        && close(x.average_area.x, y.average_area.x, tol) && close(x.average_area.y, y.average_area.y, tol)
+        && close(x.average_area.z, y.average_area.z, tol) && close(x.average_area.radius, y.average_area.radius, tol);
+}
+
+// data ------------------------------------------------------------------------------
+// [0, 1) from raw generator bits (std distributions differ between standard libraries)
+inline double unit(std::mt19937_64& rng)
+{
+    return static_cast<double>(rng() >> 11) * 0x1.0p-53;
+}
+
+inline double axis(std::mt19937_64& rng)
+{
+    return -1.0 + 2.0 * unit(rng);
+}
+
+/*
+Random walk in the VAD cube with irregular gaps: some repeated timestamps (dt = 0),
+some long pauses, so every dt branch of the kernels runs.
+*/
+inline VADHistory random_history(std::size_t n, std::uint64_t seed, const std::vector<std::string>& owners = {"x"})
+{
+    std::mt19937_64 rng(seed);
+    VADHistory history;
+    std::vector<std::uint32_t> ids;
+    for (const std::string& name : owners)
+        ids.push_back(history.intern_owner(name));
+
+    double v = 0, a = 0, d = 0, t = 1000.0;
+    history.reserve(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        v = std::clamp(0.9 * v + 0.3 * axis(rng), -1.0, 1.0);
+        a = std::clamp(0.9 * a + 0.3 * axis(rng), -1.0, 1.0);
+        d = std::clamp(0.9 * d + 0.3 * axis(rng), -1.0, 1.0);
+
+        const double gap = unit(rng);
+        t += (gap < 0.05) ? 0.0 : (gap > 0.98) ? 300.0 * unit(rng) : 5.0 * unit(rng);
+        history.push_back(v, a, d, t, ids[rng() % ids.size()]);
+    }
+    return history;
+}
+
+// EGO_compute with the newest sample as current and the one before as prev
+inline AnalysisResult analyze(const HistorySpan& history, unsigned int threads = 1)
+{
+    const VADPoint current = history.point(history.size - 1);
+    std::optional<VADPoint> prev;
+    if (history.size > 1)
+        prev = history.point(history.size - 2);
+    return EGO_compute(current, history, prev, std::nullopt, std::nullopt, std::nullopt, threads);
+}
@@ -0,0 +1,36 @@
+#include "test_common.hpp"
+#include "EGO_compact.hpp"
+
+// CompactHistory vs EGO_compute on the full history
+TEST_CASE(compact)
+{
+    compaction_policy policy;
+    policy.recent = 256;
+    policy.block_size = 32;
+    policy.max_blocks = 16;
+    CompactHistory compact(policy);
+
+    const VADHistory history = random_history(60000, 4);
+    for (std::size_t i = 0; i < history.size(); i++)
+    {
+        compact.push(history.at(i));
+        if ((i + 1) % 15000 != 0 && i != 100)
+            continue;
+
+        const AnalysisResult full = analyze(history.span().sub(0, i + 1));
+        const AnalysisResult folded = EGO_compute(compact);
+        CHECK(compact.size() == i + 1);
+        CHECK(compact.recent().size < policy.recent + policy.block_size);   // folds a whole block at a time
+        CHECK(close(folded.cumulative.stress, full.cumulative.stress));
+        CHECK(close(folded.cumulative.reward, full.cumulative.reward));
+        CHECK(close(folded.cumulative.average_area.x, full.cumulative.average_area.x));
+        CHECK(close(folded.cumulative.average_area.y, full.cumulative.average_area.y));
+        CHECK(close(folded.cumulative.average_area.z, full.cumulative.average_area.z));
+        CHECK(std::fabs(folded.cumulative.average_area.radius - full.cumulative.average_area.radius)
+              <= radius_error_bound(compact) + 1e-12);
+        // current / prev are the newest samples, so the O(1) part is identical
+        CHECK(folded.instant.stress == full.instant.stress);
+        CHECK(folded.dynamics.affective_lability == full.dynamics.affective_lability);
+    }
+    CHECK(compact.blocks().size() <= policy.max_blocks + 1);
+}
@@ -0,0 +1,80 @@
+#include "test_common.hpp"
+#include "EGO_events.hpp"
+#include "EGO_session.hpp"
+#include <memory>
+
+namespace
+{
+    AnalysisResult with_metrics(double stress, double lability, double deviation)
+    {
+        AnalysisResult result{};
+        result.instant.stress = stress;
+        result.dynamics.affective_lability = lability;
+        result.instant.deviation = deviation;
+        return result;
+    }
+}
+
+// detector transitions (hold, end, whiplash), per-stream radius and queue overflow
+TEST_CASE(events)
+{
+    // rule 0: stress > 0.7 held for 10 s, rule 1: whiplash without end events
+    EventDetector det({event_rule{event_metric::instant_stress, 0.7, 10.0, true},
+                       event_rule{event_metric::affective_lability, 0.8, 0.0, false}});
+
+    det.observe(1, 0.0, with_metrics(0.9, 0.1, 0.0));     // above, not held yet
+    det.observe(1, 5.0, with_metrics(0.9, 0.9, 0.0));     // whiplash starts at once
+    det.observe(1, 10.0, with_metrics(0.8, 0.2, 0.0));    // stress held 10 s -> start; whiplash ends silently
+    det.observe(1, 12.0, with_metrics(0.95, 0.2, 0.0));   // still active, nothing new
+    det.observe(1, 13.0, with_metrics(0.5, 0.2, 0.0));    // stress drops -> end
+    det.observe(2, 13.0, with_metrics(0.9, 0.2, 0.0));    // other stream, own state
+
+    const std::vector<DetectorEvent> events = det.drain();
+    CHECK(events.size() == 3);
+    if (events.size() == 3)
+    {
+        CHECK(events[0].stream == 1 && events[0].rule == 1 && events[0].kind == 0 && events[0].timestamp == 5.0);
+        CHECK(events[1].stream == 1 && events[1].rule == 0 && events[1].kind == 0 && events[1].timestamp == 10.0 && events[1].value == 0.8);
+        CHECK(events[2].stream == 1 && events[2].rule == 0 && events[2].kind == 1 && events[2].timestamp == 13.0);
+    }
+    CHECK(det.drain().empty());
+
+    // a dip resets the hold timer
+    det.observe(3, 0.0, with_metrics(0.9, 0.0, 0.0));
+    det.observe(3, 6.0, with_metrics(0.1, 0.0, 0.0));
+    det.observe(3, 8.0, with_metrics(0.9, 0.0, 0.0));
+    det.observe(3, 15.0, with_metrics(0.9, 0.0, 0.0));
+    CHECK(det.drain().empty());
+    det.observe(3, 18.0, with_metrics(0.9, 0.0, 0.0));
+    CHECK(det.drain().size() == 1);
+
+    // outside_radius: the same deviation is outside a 0.2 radius and inside a 0.5 one
+    EventDetector radius({event_rule{event_metric::outside_radius, 0.0, 0.0, true}});
+    radius.observe(1, 0.0, with_metrics(0.0, 0.0, 0.3), 0.2);
+    radius.observe(2, 0.0, with_metrics(0.0, 0.0, 0.3), 0.5);
+    const std::vector<DetectorEvent> left = radius.drain();
+    CHECK(left.size() == 1 && left[0].stream == 1 && close(left[0].value, 0.1, 1e-12));
+
+    // SessionManager passes each character's own stabilityRadius
+    SessionManager sessions(4);
+    CharacterSettings narrow, wide;
+    narrow.emotion_base.stabilityRadius = 0.1;
+    wide.emotion_base.stabilityRadius = 2.0;
+    sessions.create(10, narrow);
+    sessions.create(11, wide);
+    sessions.set_detector(std::make_shared<EventDetector>(std::vector<event_rule>{event_rule{event_metric::outside_radius, 0.0, 0.0, true}}));
+    sessions.push(10, 0.8, 0.5, 0.1, 1.0);
+    sessions.push(11, 0.8, 0.5, 0.1, 1.0);
+    const std::vector<DetectorEvent> outside = sessions.get_detector()->drain();
+    CHECK(outside.size() == 1 && outside[0].stream == 10);
+
+    // overflow: capacity rounds up to a power of two, the rest is counted, never blocks
+    EventDetector small({event_rule{event_metric::instant_stress, 0.5, 0.0, true}}, 5);
+    for (std::uint64_t stream = 0; stream < 20; stream++)
+        small.observe(stream, 0.0, with_metrics(0.9, 0.0, 0.0));
+    CHECK(small.dropped() == 12);
+    CHECK(small.drain(3).size() == 3);
+    CHECK(small.drain().size() == 5);
+    small.observe(99, 0.0, with_metrics(0.9, 0.0, 0.0));
+    CHECK(small.drain().size() == 1 && small.dropped() == 12);
+}
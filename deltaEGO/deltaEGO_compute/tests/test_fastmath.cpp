@@ -0,0 +1,42 @@
+#include "test_common.hpp"
+#include "EGO_fastmath.hpp"
+
+namespace
+{
+    // distance in units in the last place (both finite, same sign or both near zero)
+    std::uint64_t ulp_distance(double x, double y)
+    {
+        auto ordered = [](double z)
+        {
+            const std::uint64_t bits = double_to_bits(z);
+            return (bits >> 63) ? ~bits + 1 + (std::uint64_t(1) << 63) : bits + (std::uint64_t(1) << 63);
+        };
+        const std::uint64_t a = ordered(x), b = ordered(y);
+        return (a > b) ? a - b : b - a;
+    }
+}
+
+// the documented bounds: fast_exp 3 ulp, fast_atan2 2 ulp against libm
+TEST_CASE(fastmath)
+{
+    std::mt19937_64 rng(47);
+    std::uint64_t exp_worst = 0, atan2_worst = 0;
+    for (int i = 0; i < 2000000; i++)
+    {
+        const double x = -708.0 + 1417.0 * unit(rng);
+        exp_worst = std::max(exp_worst, ulp_distance(fast_exp(x), std::exp(x)));
+
+        // magnitudes from 1e-8 to 1e8, every quadrant
+        const double y = axis(rng) * std::pow(10.0, 16.0 * unit(rng) - 8.0);
+        const double z = axis(rng) * std::pow(10.0, 16.0 * unit(rng) - 8.0);
+        atan2_worst = std::max(atan2_worst, ulp_distance(fast_atan2(y, z), std::atan2(y, z)));
+    }
+    CHECK(exp_worst <= 3);
+    CHECK(atan2_worst <= 2);
+
+    // signed zeros and axes as std::atan2
+    for (double y : {0.0, -0.0, 1.0, -1.0})
+        for (double z : {0.0, -0.0, 1.0, -1.0})
+            CHECK(fast_atan2(y, z) == std::atan2(y, z) && std::signbit(fast_atan2(y, z)) == std::signbit(std::atan2(y, z)));
+    CHECK(std::isfinite(fast_exp(1e6)) && fast_exp(-1e6) > 0.0);
+}
@@ -0,0 +1,76 @@
+#include "test_common.hpp"
+#include "EGO_index.hpp"
+
+namespace
+{
+    double brute_rms_radius(const HistorySpan& history)
+    {
+        double v = 0, a = 0, d = 0;
+        for (std::size_t i = 0; i < history.size; i++)
+        {
+            v += history.v_at(i); a += history.a_at(i); d += history.d_at(i);
+        }
+        v /= history.size; a /= history.size; d /= history.size;
+
+        double sq = 0;
+        for (std::size_t i = 0; i < history.size; i++)
+            sq += std::pow(history.v_at(i) - v, 2) + std::pow(history.a_at(i) - a, 2) + std::pow(history.d_at(i) - d, 2);
+        return std::sqrt(sq / history.size);
+    }
+}
+
+// HistoryIndex::query vs EGO_compute on the same slice
+TEST_CASE(index)
+{
+    const VADHistory history = random_history(20000, 2);
+    const HistorySpan span = history.span();
+    const HistoryIndex index(span);
+    CHECK(index.size() == span.size);
+
+    std::mt19937_64 rng(3);
+    const double t_first = span.timestamp_at(0);
+    const double t_last = span.timestamp_at(span.size - 1);
+    for (int q = 0; q < 50; q++)
+    {
+        double t0 = t_first + unit(rng) * (t_last - t_first);
+        double t1 = t_first + unit(rng) * (t_last - t_first);
+        if (t0 > t1)
+            std::swap(t0, t1);
+
+        std::size_t first = 0, last = 0;
+        while (first < span.size && span.timestamp_at(first) < t0)
+            first++;
+        last = first;
+        while (last < span.size && span.timestamp_at(last) <= t1)
+            last++;
+        CHECK(index.count(t0, t1) == last - first);
+        if (last - first < 2)
+            continue;
+
+        const HistorySpan slice = span.sub(first, last);
+        const CumulativeMetrics expect = analyze(slice).cumulative;
+        const CumulativeMetrics got = index.query(t0, t1);
+        CHECK(close(got.stress, expect.stress));
+        CHECK(close(got.reward, expect.reward));
+        CHECK(close(got.average_area.x, expect.average_area.x));
+        CHECK(close(got.average_area.y, expect.average_area.y));
+        CHECK(close(got.average_area.z, expect.average_area.z));
+        // the index radius is the RMS distance to the center
+        CHECK(close(got.average_area.radius, brute_rms_radius(slice)));
+    }
+
+    // timestamps that step back are indexed, not rejected, and integrate like EGO_compute
+    VADHistory skewed;
+    const std::uint32_t owner = skewed.intern_owner("x");
+    HistoryIndex streamed;
+    const double ts[] = {10, 11, 9, 12, 12, 13, 8, 20};
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        skewed.push_back(0.1 * i - 0.3, 0.05 * i, -0.1, ts[i], owner);
+        streamed.push(skewed.at(i));
+    }
+    const CumulativeMetrics whole = streamed.query(0, 100);
+    CHECK(streamed.size() == 8);
+    CHECK(close(whole.stress, analyze(skewed.span()).cumulative.stress));
+    CHECK(close(whole.reward, analyze(skewed.span()).cumulative.reward));
+}
@@ -0,0 +1,50 @@
+#include "test_common.hpp"
+#ifdef DELTAEGO_HISTORY_LOG
+#include "EGO_log.hpp"
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+// HistoryLog reopened after a crash in the middle of a record
+TEST_CASE(log)
+{
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const std::string path = (dir / ("ego_compute_tests_" + std::to_string(::getpid()) + ".egolog")).string();
+    std::filesystem::remove(path);
+    std::filesystem::remove(path + ".owners");
+
+    const VADHistory history = random_history(5000, 6, {"Fuli", "User"});
+    {
+        HistoryLog log(path, 1000);
+        for (std::size_t i = 0; i < history.size(); i++)
+            log.append(history.at(i));
+    }
+
+    // torn write: part of the next record
+    {
+        std::ofstream torn(path, std::ios::binary | std::ios::app);
+        const char partial[17] = {};
+        torn.write(partial, sizeof partial);
+    }
+
+    {
+        HistoryLog log(path);
+        CHECK(log.size() == history.size());
+        CHECK(log.owners().size() == 2);
+        for (std::size_t i = 0; i < history.size(); i += 499)
+            CHECK(log.at(i).owner == history.at(i).owner && log.at(i).v == history.at(i).v);
+        CHECK(same_cumulative(analyze(log.span()).cumulative, analyze(history.span()).cumulative));
+
+        // appends after the cut land on a record boundary
+        log.append(VADPoint{0.25, -0.5, 0.75, 1e9, "User"});
+        CHECK(log.size() == history.size() + 1);
+    }
+
+    HistoryLog reopened(path);
+    CHECK(reopened.size() == history.size() + 1);
+    CHECK(reopened.at(history.size()).a == -0.5 && reopened.at(history.size()).owner == "User");
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(path + ".owners");
+}
+#endif
@@ -0,0 +1,50 @@
+/*
+ * Native tests of the compute core (no Python needed).
+ * Every fast path is checked against the plain computation it replaces; one file per feature,
+ * tests/test_<case>.cpp, each registered as a ctest entry in CMakeLists.txt.
+ *
+ *   ego_compute_tests [case]    no case -> every case; exit code 1 if any check failed
+ */
+#include "test_common.hpp"
+#include <cstdio>
+#include <cstring>
+
+std::vector<TestCase>& test_cases()
+{
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+int& test_failures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+void test_check(bool ok, const char* what, const char* file, int line)
+{
+    if (ok)
+        return;
+    test_failures()++;
+    std::printf("  FAIL %s:%d  %s\n", file, line, what);
+}
+
+int main(int argc, char** argv)
+{
+    bool found = false;
+    for (const TestCase& c : test_cases())
+    {
+        if (argc > 1 && std::strcmp(argv[1], c.name) != 0)
+            continue;
+        found = true;
+        const int before = test_failures();
+        c.run();
+        std::printf("%-10s %s\n", c.name, test_failures() == before ? "ok" : "FAILED");
+    }
+    if (!found)
+    {
+        std::printf("unknown case: %s\n", argc > 1 ? argv[1] : "");
+        return 1;
+    }
+    return test_failures() ? 1 : 0;
+}
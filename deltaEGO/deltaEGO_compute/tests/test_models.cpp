@@ -0,0 +1,87 @@
+#include "test_common.hpp"
+#include "EGO_model.hpp"
+#include <stdexcept>
+
+namespace
+{
+    // non-linear model only this file knows about
+    struct squared_model
+    {
+        explicit squared_model(const Interval_Params&) {}
+        double stress(double, double A) const { return clamp01(A * A); }
+        double reward(double V, double) const { return clamp01(V * V); }
+    };
+
+    bool same_result(const AnalysisResult& x, const AnalysisResult& y)
+    {
+        return x.instant.stress == y.instant.stress && x.instant.reward == y.instant.reward
+            && x.instant.stress_ratio == y.instant.stress_ratio && x.instant.deviation == y.instant.deviation
+            && x.dynamics.affective_lability == y.dynamics.affective_lability
+            && same_cumulative(x.cumulative, y.cumulative);
+    }
+}
+
+// persona presets vs linear_model, and EGO_compute<Model> with a caller's model
+TEST_CASE(models)
+{
+    // longer than one REDUCE_BLOCK, so the caller's block kernel runs per block on several workers
+    const VADHistory history = random_history(150000, 61);
+    const EGO_axis base{VADPoint{0.1, 0.0, -0.1, 0.0}, 0.35};
+
+    compute_in in;
+    in.history_view = history.span();
+    in.current = history.at(history.size() - 1);
+    in.prev = history.at(history.size() - 2);
+    in.emotion_base = base;
+    in.threads = 3;
+
+    // registered presets (picked by with_stress_model) == the runtime-weight linear_model
+    const weight presets[] = {preset_weight<default_weight_preset>(), preset_weight<anxious_weight_preset>(),
+                              preset_weight<melancholic_weight_preset>(), preset_weight<thrill_seeker_weight_preset>()};
+    CHECK(preset_model<anxious_weight_preset>::matches(make_interval_params(base, presets[1], variable{})));
+    for (const weight& w : presets)
+    {
+        in.weights = w;
+        CHECK(same_result(EGO_compute(in), EGO_compute<linear_model>(in)));
+    }
+
+    // strided view: the block kernel picks its runtime stride
+    std::vector<double> rows;
+    for (std::size_t i = 0; i < history.size(); i++)
+        rows.insert(rows.end(), {history.v[i], history.a[i], history.d[i], history.timestamp[i]});
+    compute_in strided = in;
+    strided.history_view = HistorySpan{&rows[0], &rows[1], &rows[2], &rows[3], history.size(), 4};
+    CHECK(same_result(EGO_compute<linear_model>(strided), EGO_compute(in)));
+
+    // a caller's model: O(1) and lifetime integral use its formulas
+    in.weights.reset();
+    const AnalysisResult squared = EGO_compute<squared_model>(in);
+    const variable v{};
+    const HistorySpan span = history.span();
+
+    const double distance = squared.instant.deviation;
+    const double damp = (distance <= base.stabilityRadius) ? v.dampening_factor : 1.0;
+    CHECK(squared.instant.stress == std::min(1.0, in.current.a * in.current.a) * damp);
+    CHECK(squared.instant.reward == std::min(1.0, in.current.v * in.current.v));
+
+    double stress = 0, reward = 0;
+    for (std::size_t i = 1; i < span.size; i++)
+    {
+        const double dt_raw = span.timestamp_at(i) - span.timestamp_at(i - 1);
+        const double dt = (dt_raw <= 0) ? 0.1 : dt_raw;
+        const double dv = span.v_at(i) - base.baseline.v, da = span.a_at(i) - base.baseline.a, dd = span.d_at(i) - base.baseline.d;
+        const double inside = (dv*dv + da*da + dd*dd <= base.stabilityRadius * base.stabilityRadius) ? v.dampening_factor : 1.0;
+        stress += std::min(1.0, span.a_at(i) * span.a_at(i)) * inside * dt;
+        reward += std::min(1.0, span.v_at(i) * span.v_at(i)) * dt;
+    }
+    CHECK(close(squared.cumulative.stress, stress));
+    CHECK(close(squared.cumulative.reward, reward));
+    CHECK(squared.cumulative.average_area.radius == EGO_compute(in).cumulative.average_area.radius);
+
+    // only lifetime cumulative goes through a caller's model
+    in.cumulative = cumulative_option{cumulative_mode::window, 60.0, 600.0, 1.0, resample_mode::linear};
+    bool threw = false;
+    try { EGO_compute<squared_model>(in); }
+    catch (const std::invalid_argument&) { threw = true; }
+    CHECK(threw);
+}
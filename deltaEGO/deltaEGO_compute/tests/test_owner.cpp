@@ -0,0 +1,29 @@
+#include "test_common.hpp"
+#include "EGO_owner.hpp"
+#include <map>
+
+// EGO_compute_by_owner vs one EGO_compute per owner split
+TEST_CASE(owner)
+{
+    const VADHistory history = random_history(30000, 7, {"Fuli", "User", "Narrator"});
+
+    std::map<std::string, VADHistory> parts;
+    for (std::size_t i = 0; i < history.size(); i++)
+    {
+        const VADPoint point = history.at(i);
+        parts[point.owner].push_back(point);
+    }
+
+    const std::vector<OwnerAnalysis> results = EGO_compute_by_owner(history, std::nullopt, std::nullopt, std::nullopt);
+    CHECK(results.size() == parts.size());
+    for (const OwnerAnalysis& result : results)
+    {
+        const VADHistory& part = parts[result.owner];
+        const AnalysisResult expect = analyze(part.span());
+        CHECK(result.count == part.size());
+        CHECK(close_cumulative(result.analysis.cumulative, expect.cumulative));
+        CHECK(result.analysis.instant.stress == expect.instant.stress);
+        CHECK(result.analysis.instant.deviation == expect.instant.deviation);
+        CHECK(result.analysis.dynamics.affective_lability == expect.dynamics.affective_lability);
+    }
+}
@@ -0,0 +1,79 @@
+#include "test_common.hpp"
+#include "EGO_batch.hpp"
+#include "EGO_owner.hpp"
+#include "EGO_series.hpp"
+#include "EGO_sweep.hpp"
+
+// precision reaches batch / sweep / by_owner: fast matches the fast series, exact stays libm
+TEST_CASE(precision)
+{
+    const VADHistory full = random_history(2000, 53, {"a", "b"});
+    const weight w{0.6, 0.4, 0.5, 0.5, 1.7};
+    const variable vars{0.3, 0.08};
+
+    // end the history on a sample where the fast lability is a few ulp off, so the switch is visible
+    const MetricSeries exact_all = EGO_compute_series(full.span(), std::nullopt, vars, w, 2, math_precision::exact);
+    const MetricSeries fast_all = EGO_compute_series(full.span(), std::nullopt, vars, w, 2, math_precision::fast);
+    std::size_t n = 2;
+    while (n < full.size() && exact_all.affective_lability[n - 1] == fast_all.affective_lability[n - 1])
+        n++;
+    CHECK(n < full.size());
+
+    VADHistory history;
+    for (std::size_t i = 0; i < n; i++)
+        history.push_back(full.at(i));
+    const HistorySpan span = history.span();
+    const VADPoint current = span.point(n - 1);
+    const VADPoint prev = span.point(n - 2);
+
+    for (math_precision precision : {math_precision::exact, math_precision::fast})
+    {
+        const MetricSeries series = EGO_compute_series(span, std::nullopt, vars, w, 2, precision);
+        const double expect = series.affective_lability[n - 1];
+
+        compute_in in;
+        in.history_view = span;
+        in.current = current;
+        in.prev = prev;
+        in.variables = vars;
+        in.weights = w;
+        CHECK(EGO_compute_sync(in, precision).dynamics.affective_lability == expect);
+        CHECK(EGO_compute_batch({in}, 1, precision).affective_lability[0] == expect);
+
+        const std::int64_t offsets[2] = {0, static_cast<std::int64_t>(n)};
+        history_columns_in columns;
+        columns.v = span.v; columns.a = span.a; columns.d = span.d; columns.timestamp = span.timestamp;
+        columns.offsets = offsets;
+        columns.sessions = 1;
+        columns.variables = vars;
+        columns.weights = w;
+        CHECK(EGO_compute_batch_columnar(columns, 1, precision).affective_lability[0] == expect);
+
+        const AnalysisColumns sweep = EGO_compute_sweep(current, span, prev, std::nullopt, {sweep_param{w, vars}}, 1, precision);
+        CHECK(sweep.affective_lability[0] == expect);
+        // only lability depends on the precision
+        CHECK(sweep.instant_stress[0] == series.instant_stress[n - 1] && sweep.deviation[0] == series.deviation[n - 1]);
+
+        // by_owner: the owner's last two samples, same angle + sigmoid as the single path
+        for (const OwnerAnalysis& part : EGO_compute_by_owner(history, std::nullopt, vars, w, precision))
+        {
+            std::size_t last = n, before = n;
+            for (std::size_t i = n; i-- > 0 && before == n;)
+            {
+                if (history.owner_name(history.owner_id_at(i)) != part.owner)
+                    continue;
+                (last == n) ? last = i : before = i;
+            }
+            std::optional<VADPoint> owner_prev;
+            if (before < n)
+                owner_prev = span.point(before);
+            const AnalysisResult single = EGO_compute_sync(span.point(last), HistorySpan{}, owner_prev,
+                                                           std::nullopt, vars, w, precision);
+            CHECK(part.analysis.dynamics.affective_lability == single.dynamics.affective_lability);
+        }
+    }
+
+    // exact is the default everywhere
+    const AnalysisResult plain = EGO_compute(current, span, prev, std::nullopt, vars, w);
+    CHECK(plain.dynamics.affective_lability == EGO_compute_series(span, std::nullopt, vars, w).affective_lability[n - 1]);
+}
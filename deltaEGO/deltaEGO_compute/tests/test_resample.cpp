@@ -0,0 +1,62 @@
+#include "test_common.hpp"
+#include "EGO_resample.hpp"
+
+// max_gap_points caps one long gap, and leaves ordinary histories alone
+TEST_CASE(resample)
+{
+    // first sample at 0, the rest at unix time: one 1.7e9 step gap
+    VADHistory jump;
+    const std::uint32_t id = jump.intern_owner("x");
+    jump.push_back(0.1, 0.2, 0.3, 0.0, id);
+    for (int i = 0; i < 10; i++)
+        jump.push_back(0.5, -0.5, 0.0, 1.7e9 + i, id);
+
+    resample_option option;
+    option.step = 1.0;
+    // first point + the capped gap + one point per later second
+    CHECK(resampled_size(jump.span(), option) == 1 + option.max_gap_points + 9);
+
+    option.max_gap_points = 50;
+    CHECK(resampled_size(jump.span(), option) == 1 + 50 + 9);
+
+    // the resampled cumulative stays finite and cheap on the same history
+    compute_in in;
+    in.history = jump;
+    in.current = jump.at(jump.size() - 1);
+    in.cumulative = cumulative_option{cumulative_mode::resampled, 3600.0, 600.0, 1.0, resample_mode::linear};
+    const AnalysisResult result = EGO_compute(in);
+    CHECK(std::isfinite(result.cumulative.stress) && std::isfinite(result.cumulative.average_area.radius));
+
+    // ordinary gaps (at most a few hundred steps) are never capped
+    const VADHistory history = random_history(3000, 31);
+    resample_option unlimited;
+    unlimited.max_gap_points = 0;
+    for (double step : {0.5, 1.0, 7.0})
+    {
+        option.step = unlimited.step = step;
+        option.max_gap_points = 10000;
+        const std::size_t expect = static_cast<std::size_t>(std::floor(
+            (history.timestamp.back() - history.timestamp.front()) / step)) + 1;
+        CHECK(resampled_size(history.span(), unlimited) == expect);
+        CHECK(resampled_size(history.span(), option) == expect);
+    }
+
+    // hold mode emits the last max_gap_points grid points of the gap, old value until t
+    resample_option hold;
+    hold.mode = resample_mode::hold;
+    hold.max_gap_points = 5;
+    Resampler resampler(hold);
+    std::vector<VADPoint> out;
+    auto emit = [&](double v, double a, double d, double t) { out.push_back(VADPoint{v, a, d, t}); };
+    resampler.push(1.0, 1.0, 1.0, 0.0, emit);
+    resampler.push(2.0, 2.0, 2.0, 100.0, emit);
+
+    CHECK(out.size() == 6);
+    if (out.size() == 6)
+    {
+        CHECK(out[0].timestamp == 0.0 && out[0].v == 1.0);
+        for (std::size_t k = 1; k < 5; k++)
+            CHECK(out[k].timestamp == 95.0 + static_cast<double>(k) && out[k].v == 1.0);
+        CHECK(out[5].timestamp == 100.0 && out[5].v == 2.0);
+    }
+}
@@ -0,0 +1,37 @@
+#include "test_common.hpp"
+#include "EGO_series.hpp"
+
+// EGO_compute_series row i vs EGO_compute on the prefix ending at sample i
+TEST_CASE(series)
+{
+    const VADHistory history = random_history(4000, 11);
+    const HistorySpan span = history.span();
+    const EGO_axis base{VADPoint{-0.1, 0.05, 0.1, 0.0}, 0.4};
+    const weight w{0.65, 0.35, 0.55, 0.45, 1.3};
+    const variable vars{0.2, 0.1};
+
+    const MetricSeries exact = EGO_compute_series(span, base, vars, w, 4, math_precision::exact);
+    const MetricSeries fast = EGO_compute_series(span, base, vars, w, 4, math_precision::fast);
+    CHECK(exact.size() == span.size && fast.size() == span.size);
+
+    for (std::size_t i = 0; i < span.size && i < exact.size(); i++)
+    {
+        std::optional<VADPoint> prev;
+        if (i > 0)
+            prev = span.point(i - 1);
+        const AnalysisResult expect = EGO_compute(span.point(i), span.sub(0, i + 1), prev, base, vars, w);
+
+        CHECK(exact.instant_stress[i] == expect.instant.stress);
+        CHECK(exact.instant_reward[i] == expect.instant.reward);
+        CHECK(exact.instant_ratio_total[i] == expect.instant.ratio_total);
+        CHECK(exact.instant_stress_ratio[i] == expect.instant.stress_ratio);
+        CHECK(exact.deviation[i] == expect.instant.deviation);
+        CHECK(exact.delta_v[i] == expect.dynamics.delta.v);
+        CHECK(exact.delta_d[i] == expect.dynamics.delta.d);
+        CHECK(exact.affective_lability[i] == expect.dynamics.affective_lability);
+
+        // fast math only touches the lability column, by a few ulp
+        CHECK(fast.instant_stress[i] == exact.instant_stress[i]);
+        CHECK(close(fast.affective_lability[i], exact.affective_lability[i], 1e-14));
+    }
+}
@@ -0,0 +1,53 @@
+#include "test_common.hpp"
+#include "EGO_session.hpp"
+#include <stdexcept>
+
+// SessionManager::push_batch vs push() one sample at a time in input order
+TEST_CASE(session)
+{
+    std::mt19937_64 rng(8);
+    const std::size_t count = 4000;
+    std::vector<character_id> ids(count);
+    std::vector<double> V(count), A(count), D(count), timestamp(count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        ids[i] = rng() % 37;     // interleaved samples of the same ids, several ids per shard
+        V[i] = axis(rng);
+        A[i] = axis(rng);
+        D[i] = axis(rng);
+        timestamp[i] = 100.0 + i * 0.5;
+    }
+
+    SessionManager batched(4), single(4);
+    std::vector<AnalysisResult> results;
+    for (std::size_t begin = 0; begin < count; begin += 1000)
+    {
+        const auto slice = [&](const auto& column) { return std::vector(column.begin() + begin, column.begin() + begin + 1000); };
+        const std::vector<AnalysisResult> part = batched.push_batch(slice(ids), slice(V), slice(A), slice(D), slice(timestamp), 4);
+        results.insert(results.end(), part.begin(), part.end());
+    }
+    CHECK(results.size() == count);
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const AnalysisResult expect = single.push(ids[i], V[i], A[i], D[i], timestamp[i]);
+        CHECK(same_cumulative(results[i].cumulative, expect.cumulative));
+        CHECK(results[i].instant.stress == expect.instant.stress);
+        CHECK(results[i].dynamics.affective_lability == expect.dynamics.affective_lability);
+    }
+
+    // every character's history keeps the input order
+    CHECK(batched.size() == single.size());
+    for (character_id id = 0; id < 37; id++)
+    {
+        const VADHistory a = batched.history(id), b = single.history(id);
+        CHECK(a.size() == b.size());
+        for (std::size_t i = 0; i < a.size() && i < b.size(); i++)
+            CHECK(a.at(i).timestamp == b.at(i).timestamp && a.at(i).v == b.at(i).v);
+    }
+
+    bool threw = false;
+    try { batched.push_batch({1, 2}, {0.1}, {0.1}, {0.1}, {0.1}); }
+    catch (const std::invalid_argument&) { threw = true; }
+    CHECK(threw);
+}
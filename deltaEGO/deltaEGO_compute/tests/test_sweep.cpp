@@ -0,0 +1,42 @@
+#include "test_common.hpp"
+#include "EGO_sweep.hpp"
+
+// EGO_compute_sweep vs one EGO_compute per configuration
+TEST_CASE(sweep)
+{
+    const VADHistory history = random_history(5000, 9);
+    const HistorySpan span = history.span();
+    const VADPoint current = span.point(span.size - 1);
+    const VADPoint prev = span.point(span.size - 2);
+    const EGO_axis base{VADPoint{0.1, -0.05, 0.2, 0.0}, 0.35};
+
+    std::vector<weight> weights(1);     // the default weights take the preset kernel
+    std::vector<variable> variables(1);
+    std::mt19937_64 rng(10);
+    for (int k = 0; k < 7; k++)
+        weights.push_back(weight{unit(rng), unit(rng), unit(rng), unit(rng), 2.0 * unit(rng)});
+    for (int k = 0; k < 7; k++)
+        variables.push_back(variable{axis(rng), 0.2 * unit(rng)});
+
+    const std::vector<sweep_param> params = make_sweep_grid(weights, variables);
+    CHECK(params.size() == 64);
+
+    const AnalysisColumns sweep = EGO_compute_sweep(current, span, prev, base, params, 4);
+    CHECK(sweep.size() == params.size());
+    for (std::size_t k = 0; k < params.size() && k < sweep.size(); k++)
+    {
+        const AnalysisResult expect = EGO_compute(current, span, prev, base, params[k].variables, params[k].weights);
+
+        // O(1) part: the same calculate_instant_shared + fill_instant_metrics
+        CHECK(sweep.instant_stress[k] == expect.instant.stress);
+        CHECK(sweep.instant_reward[k] == expect.instant.reward);
+        CHECK(sweep.deviation[k] == expect.instant.deviation);
+        CHECK(sweep.affective_lability[k] == expect.dynamics.affective_lability);
+
+        // history part: shared columns, another summation order
+        CHECK(close(sweep.cumulative_stress[k], expect.cumulative.stress));
+        CHECK(close(sweep.cumulative_reward[k], expect.cumulative.reward));
+        CHECK(close(sweep.average_x[k], expect.cumulative.average_area.x));
+        CHECK(close(sweep.average_radius[k], expect.cumulative.average_area.radius));
+    }
+}
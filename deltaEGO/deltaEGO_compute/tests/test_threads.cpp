@@ -0,0 +1,32 @@
+#include "test_common.hpp"
+
+/*
+The lifetime kernel reduces fixed blocks of REDUCE_BLOCK (2^16) samples, so the result must
+not depend on how many workers take the blocks.
+*/
+TEST_CASE(threads)
+{
+    const VADHistory history = random_history(300000, 1);
+
+    compute_in in;
+    in.history = history;
+    in.current = history.at(history.size() - 1);
+    in.prev = history.at(history.size() - 2);
+    in.lability = lability_option{0.6, 0.0, math_precision::exact};
+
+    in.threads = 1;
+    const AnalysisResult one = EGO_compute(in);
+    for (unsigned int threads : {2u, 3u, 8u, 0u})
+    {
+        in.threads = threads;
+        const AnalysisResult many = EGO_compute(in);
+        CHECK(same_cumulative(one.cumulative, many.cumulative));
+        CHECK(one.lability->mean == many.lability->mean);
+        CHECK(one.lability->max == many.lability->max);
+        CHECK(one.lability->above_threshold == many.lability->above_threshold);
+    }
+
+    // and the single-threaded entry point
+    const AnalysisResult sync = EGO_compute_sync(in);
+    CHECK(same_cumulative(one.cumulative, sync.cumulative));
+}
@@ -0,0 +1,109 @@
+#include "test_common.hpp"
+#include "EGO_window.hpp"
+
+namespace
+{
+    // instant stress / reward of one sample from the O(1) path (no dt): the brute-force integrand
+    Interval_Terms instant_terms(const VADPoint& point)
+    {
+        compute_in in;
+        in.current = point;
+        const AnalysisResult r = EGO_compute_sync(in);
+        return Interval_Terms{r.instant.stress, r.instant.reward};
+    }
+
+    double interval_dt(const HistorySpan& history, std::size_t i)
+    {
+        const double dt = history.timestamp_at(i) - history.timestamp_at(i - 1);
+        return (dt <= 0) ? 0.1 : dt;
+    }
+
+    // window / decay straight from their definitions, O(n) EGO_compute calls
+    CumulativeMetrics brute_window(const HistorySpan& history, double window_seconds)
+    {
+        const std::size_t n = history.size;
+        const double oldest = history.timestamp_at(n - 1) - window_seconds;
+        std::size_t start = 0;
+        while (history.timestamp_at(start) < oldest)
+            start++;
+
+        double v = 0, a = 0, d = 0, stress = 0, reward = 0;
+        for (std::size_t i = start; i < n; i++)
+        {
+            v += history.v_at(i); a += history.a_at(i); d += history.d_at(i);
+            if (i > start)
+            {
+                const Interval_Terms terms = instant_terms(history.point(i));
+                stress += terms.stress * interval_dt(history, i);
+                reward += terms.reward * interval_dt(history, i);
+            }
+        }
+        const double count = static_cast<double>(n - start);
+        v /= count; a /= count; d /= count;
+
+        double r = 0;
+        for (std::size_t i = start; i < n; i++)
+            r += std::sqrt(std::pow(history.v_at(i) - v, 2) + std::pow(history.a_at(i) - a, 2) + std::pow(history.d_at(i) - d, 2));
+        return make_cumulative_metrics(VAD_ave{v, a, d, r / count}, stress, reward);
+    }
+
+    CumulativeMetrics brute_decay(const HistorySpan& history, double half_life)
+    {
+        const std::size_t n = history.size;
+        const double t_last = history.timestamp_at(n - 1);
+
+        double w = 0, v = 0, a = 0, d = 0, sq = 0, stress = 0, reward = 0;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            const double f = std::exp2(-(t_last - history.timestamp_at(i)) / half_life);
+            const VADPoint p = history.point(i);
+            w += f; v += f * p.v; a += f * p.a; d += f * p.d;
+            sq += f * (p.v * p.v + p.a * p.a + p.d * p.d);
+            if (i > 0)
+            {
+                const Interval_Terms terms = instant_terms(p);
+                stress += f * terms.stress * interval_dt(history, i);
+                reward += f * terms.reward * interval_dt(history, i);
+            }
+        }
+        v /= w; a /= w; d /= w;
+        const double r = std::sqrt(std::max(0.0, sq / w - (v * v + a * a + d * d)));
+        return make_cumulative_metrics(VAD_ave{v, a, d, r}, stress, reward);
+    }
+}
+
+// window / decay: batch, streaming accumulators and EGO_compute vs their definitions
+TEST_CASE(window)
+{
+    const VADHistory history = random_history(3000, 5);
+    const HistorySpan span = history.span();
+    const Interval_Params params = make_interval_params(EGO_axis{}, weight{}, variable{});
+    const double window_seconds = 400.0, half_life = 150.0;
+
+    WindowAccumulator window(window_seconds);
+    DecayAccumulator decay(half_life);
+    for (std::size_t i = 0; i < span.size; i++)
+    {
+        window.push(span.point(i));
+        decay.push(span.point(i));
+        if (i % 250 != 7)
+            continue;
+
+        const HistorySpan prefix = span.sub(0, i + 1);
+        const CumulativeMetrics expect_window = brute_window(prefix, window_seconds);
+        const CumulativeMetrics expect_decay = brute_decay(prefix, half_life);
+        CHECK(close_cumulative(calculate_window_cumulative(prefix, params, window_seconds), expect_window));
+        CHECK(close_cumulative(window.metrics(), expect_window));
+        CHECK(close_cumulative(calculate_decay_cumulative(prefix, params, half_life), expect_decay));
+        CHECK(close_cumulative(decay.metrics(), expect_decay));
+    }
+
+    // the same modes through EGO_compute
+    compute_in in;
+    in.history = history;
+    in.current = history.at(history.size() - 1);
+    in.cumulative = cumulative_option{cumulative_mode::window, window_seconds, half_life};
+    CHECK(close(EGO_compute(in).cumulative.stress, brute_window(span, window_seconds).stress));
+    in.cumulative->mode = cumulative_mode::decay;
+    CHECK(close(EGO_compute(in).cumulative.reward, brute_decay(span, half_life).reward));
+}